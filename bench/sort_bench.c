@@ -0,0 +1,281 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Sort benchmark. Times every sort variant in sort.h against qsort over
+ * several input distributions, element types and sizes, and prints one CSV
+ * row per combination to stdout:
+ *
+ *   variant,type,elem_size,distribution,size,reps,median_ns,ns_per_elem
+ *
+ * Usage: sort_bench [max_size]
+ *   Sizes run in powers of ten from 10 up to max_size (default 1000000).
+ *
+ * sort, sort_dispatch and argsort load the comparison function through a
+ * volatile pointer, so the compiler cannot inline it and they pay the
+ * indirect call a comparison function stored in a collection costs.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/hurust/sort.h"
+
+typedef struct {
+    int64_t key;
+    char pad[8];
+} rec16;
+
+typedef struct {
+    int64_t key;
+    char pad[56];
+} rec64;
+
+typedef void(bench_fn_t)(void *arr, size_t size);
+
+struct bench_type {
+    const char *name;
+    size_t elem_size;
+    void (*from_keys)(void *arr, const int64_t *keys, size_t size);
+    bool (*is_sorted)(const void *arr, size_t size);
+    bench_fn_t *sort;
+    bench_fn_t *qsort;
+    bench_fn_t *sort_natural;
+    bench_fn_t *sort_dispatch;
+    bench_fn_t *sort_by_key;
+    bench_fn_t *argsort;
+};
+
+#define _prim_key(x) ((int64_t)(x))
+#define _rec_key(x) ((x).key)
+#define _prim_from_key(type, k) ((type)(k))
+#define _rec_from_key(type, k) ((type){ .key = (k) })
+
+#define BENCH_TYPE_COMMON(type, name, get_key, from_key)                            \
+    static int name##_cmp(const type a, const type b)                               \
+    {                                                                               \
+        return (get_key(a) > get_key(b)) - (get_key(a) < get_key(b));               \
+    }                                                                               \
+    static int name##_qsort_cmp(const void *a, const void *b)                       \
+    {                                                                               \
+        return name##_cmp(*(const type *)a, *(const type *)b);                      \
+    }                                                                               \
+    static int64_t name##_key(const type a)                                         \
+    {                                                                               \
+        return get_key(a);                                                          \
+    }                                                                               \
+    static void name##_from_keys(void *arr, const int64_t *keys, size_t size)       \
+    {                                                                               \
+        for (size_t i = 0; i < size; i++)                                           \
+            ((type *)arr)[i] = from_key(type, keys[i]);                             \
+    }                                                                               \
+    static bool name##_is_sorted(const void *arr, size_t size)                      \
+    {                                                                               \
+        for (size_t i = 1; i < size; i++)                                           \
+            if (name##_cmp(((const type *)arr)[i - 1], ((const type *)arr)[i]) > 0) \
+                return false;                                                       \
+        return true;                                                                \
+    }                                                                               \
+    static void name##_sort(void *arr, size_t size)                                 \
+    {                                                                               \
+        int (*volatile cmp)(const type, const type) = name##_cmp;                   \
+        sort((type *)arr, size, cmp);                                               \
+    }                                                                               \
+    static void name##_qsort(void *arr, size_t size)                                \
+    {                                                                               \
+        qsort(arr, size, sizeof(type), name##_qsort_cmp);                           \
+    }                                                                               \
+    static void name##_sort_by_key(void *arr, size_t size)                          \
+    {                                                                               \
+        sort_by_key((type *)arr, size, name##_key);                                 \
+    }                                                                               \
+    static void name##_argsort(void *arr, size_t size)                              \
+    {                                                                               \
+        size_t *idx = malloc(sizeof(size_t) * size);                                \
+        int (*volatile cmp)(const type, const type) = name##_cmp;                   \
+        argsort((type *)arr, size, cmp, idx);                                       \
+        apply_permutation((type *)arr, size, idx);                                  \
+        free(idx);                                                                  \
+    }
+
+#define BENCH_PRIM_TYPE(type, name)                               \
+    BENCH_TYPE_COMMON(type, name, _prim_key, _prim_from_key)      \
+    static void name##_sort_natural(void *arr, size_t size)       \
+    {                                                             \
+        sort_natural((type *)arr, size);                          \
+    }                                                             \
+    static void name##_sort_dispatch(void *arr, size_t size)      \
+    {                                                             \
+        int (*volatile cmp)(const type, const type) = name##_cmp; \
+        sort_dispatch((type *)arr, size, cmp);                    \
+    }
+
+#define BENCH_REC_TYPE(type, name) BENCH_TYPE_COMMON(type, name, _rec_key, _rec_from_key)
+
+#define BENCH_TYPE_ENTRY(type, name, natural, dispatch)                         \
+    {                                                                           \
+        #type, sizeof(type), name##_from_keys, name##_is_sorted, name##_sort,   \
+            name##_qsort, natural, dispatch, name##_sort_by_key, name##_argsort \
+    }
+
+BENCH_PRIM_TYPE(int, int)
+BENCH_PRIM_TYPE(int64_t, i64)
+BENCH_PRIM_TYPE(double, f64)
+BENCH_REC_TYPE(rec16, rec16)
+BENCH_REC_TYPE(rec64, rec64)
+
+static const struct bench_type bench_types[] = {
+    BENCH_TYPE_ENTRY(int, int, int_sort_natural, int_sort_dispatch),
+    BENCH_TYPE_ENTRY(int64_t, i64, i64_sort_natural, i64_sort_dispatch),
+    BENCH_TYPE_ENTRY(double, f64, f64_sort_natural, f64_sort_dispatch),
+    BENCH_TYPE_ENTRY(rec16, rec16, NULL, NULL),
+    BENCH_TYPE_ENTRY(rec64, rec64, NULL, NULL),
+};
+
+enum distribution {
+    DIST_RANDOM,
+    DIST_SORTED,
+    DIST_REVERSE,
+    DIST_ORGAN_PIPE,
+    DIST_FEW_UNIQUE,
+    DIST_SAWTOOTH,
+    DIST_COUNT,
+};
+
+static const char *dist_names[DIST_COUNT] = { "random",     "sorted",     "reverse",
+                                              "organ_pipe", "few_unique", "sawtooth" };
+
+static uint64_t xorshift64(uint64_t *state)
+{
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+static void gen_keys(enum distribution dist, int64_t *keys, size_t size)
+{
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    size_t period = size / 16 + 1;
+
+    for (size_t i = 0; i < size; i++) {
+        switch (dist) {
+        case DIST_RANDOM:
+            keys[i] = (int64_t)(xorshift64(&state) >> 33);
+            break;
+        case DIST_SORTED:
+            keys[i] = (int64_t)i;
+            break;
+        case DIST_REVERSE:
+            keys[i] = (int64_t)(size - i);
+            break;
+        case DIST_ORGAN_PIPE:
+            keys[i] = (int64_t)(i < size / 2 ? i : size - i);
+            break;
+        case DIST_FEW_UNIQUE:
+            keys[i] = (int64_t)(xorshift64(&state) % 16);
+            break;
+        case DIST_SAWTOOTH:
+            keys[i] = (int64_t)(i % period);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void run_bench(const char *variant, const struct bench_type *type, enum distribution dist,
+                      size_t size, bench_fn_t *fn, const void *src, void *work)
+{
+    size_t reps = 1000000 / size;
+    reps = reps < 3 ? 3 : reps > 1000 ? 1000 : reps;
+
+    uint64_t *times = malloc(sizeof(uint64_t) * reps);
+
+    for (size_t r = 0; r < reps; r++) {
+        memcpy(work, src, type->elem_size * size);
+        uint64_t start = now_ns();
+        fn(work, size);
+        times[r] = now_ns() - start;
+        if (r == 0 && !type->is_sorted(work, size)) {
+            fprintf(stderr, "%s produced unsorted output for %s/%s/%zu\n", variant, type->name,
+                    dist_names[dist], size);
+            exit(1);
+        }
+    }
+
+    qsort(times, reps, sizeof(uint64_t), cmp_u64);
+    uint64_t median = times[reps / 2];
+
+    printf("%s,%s,%zu,%s,%zu,%zu,%llu,%.3f\n", variant, type->name, type->elem_size,
+           dist_names[dist], size, reps, (unsigned long long)median, (double)median / size);
+    fflush(stdout);
+
+    free(times);
+}
+
+int main(int argc, char **argv)
+{
+    size_t max_size = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+
+    printf("variant,type,elem_size,distribution,size,reps,median_ns,ns_per_elem\n");
+
+    for (size_t t = 0; t < sizeof(bench_types) / sizeof(*bench_types); t++) {
+        const struct bench_type *type = &bench_types[t];
+        for (size_t size = 10; size <= max_size; size *= 10) {
+            int64_t *keys = malloc(sizeof(int64_t) * size);
+            void *src = malloc(type->elem_size * size);
+            void *work = malloc(type->elem_size * size);
+            for (int dist = 0; dist < DIST_COUNT; dist++) {
+                gen_keys(dist, keys, size);
+                type->from_keys(src, keys, size);
+                run_bench("sort", type, dist, size, type->sort, src, work);
+                run_bench("qsort", type, dist, size, type->qsort, src, work);
+                if (type->sort_natural != NULL)
+                    run_bench("sort_natural", type, dist, size, type->sort_natural, src, work);
+                if (type->sort_dispatch != NULL)
+                    run_bench("sort_dispatch", type, dist, size, type->sort_dispatch, src, work);
+                run_bench("sort_by_key", type, dist, size, type->sort_by_key, src, work);
+                run_bench("argsort", type, dist, size, type->argsort, src, work);
+            }
+            free(keys);
+            free(src);
+            free(work);
+        }
+    }
+
+    return 0;
+}
@@ -61,16 +61,61 @@
 
 #define _typeofarray(arr) typeof(*(arr))
 
+/**
+ * \brief       Growth policy structure for dynamic collections.
+ * \note        This structure decides how a dynamic collection grows when it
+ *              is full and when it gives memory back after removals.
+ *              growth_factor is the factor the capacity is multiplied by
+ *              when growing, and should be greater than 1. The capacity is
+ *              halved when the size drops below cap / shrink_threshold, so
+ *              a threshold greater than 2 leaves a gap between the shrink
+ *              and grow points and stops push/pop churn from reallocating.
+ *              The capacity never drops below min_cap, and never_shrink
+ *              disables shrinking completely.
+ */
+typedef struct hr_growth_policy_t {
+    float growth_factor;
+    size_t shrink_threshold;
+    size_t min_cap;
+    bool never_shrink;
+} HRGrowthPolicy;
+
+// The default growth policy, which doubles when full and halves when less than a quarter full.
+const HRGrowthPolicy hr_default_growth_policy = { 2.0f, 4, 1, false };
+
+#define HR_DEFAULT_GROWTH_POLICY (&hr_default_growth_policy)
+
+/**
+ * \brief       A macro for computing the capacity a structure should grow to.
+ * \note        This macro grows the given capacity by the growth factor of
+ *              the policy until it can hold the needed number of items.
+ * \param[in]   policy The growth policy to use.
+ * \param[in]   cap The current capacity.
+ * \param[in]   needed The number of items the capacity must fit.
+ */
+#define _policy_grow_cap(policy, cap, needed)                                  \
+    ({                                                                         \
+        const size_t _needed = (needed);                                       \
+        size_t _grown = (cap) > (policy)->min_cap ? (cap) : (policy)->min_cap; \
+        while (_grown < _needed) {                                             \
+            size_t _next = (size_t)(_grown * (policy)->growth_factor);         \
+            _grown = _next > _grown ? _next : _grown + 1;                      \
+        }                                                                      \
+        _grown;                                                                \
+    })
+
 /**
  * \brief       A macro ensuring that the given structure has enough capacity
  *              for another item.
- * \note        This macro doubles the capacity of the structure if it is full.
+ * \note        This macro grows the capacity of the structure by its growth
+ *              policy if it is full.
  * \param[in]   structure The structure to ensure capacity for.
  */
 #define _ensure_cap(structure)                                                                    \
     {                                                                                             \
-        if ((structure)->size == (structure)->cap - 1) {                                          \
-            (structure)->cap <<= 1;                                                               \
+        if ((structure)->size >= (structure)->cap) {                                              \
+            (structure)->cap =                                                                    \
+                _policy_grow_cap((structure)->policy, (structure)->cap, (structure)->size + 1);   \
             (structure)->data =                                                                   \
                 (structure)->allocator->realloc((structure)->allocator->arena, (structure)->data, \
                                                 (structure)->cap * sizeof(*(structure)->data));   \
@@ -78,22 +123,133 @@
     }
 
 /**
- * \brief       A macro ensuring that the given structure doesn't hold too much
- *              unused capacity.
- * \note        This macro halves the capacity of the structure if it is less
- *              than a quarter full.
- * \param[in]   structure The structure to reduce capacity for.
+ * \brief       A macro ensuring that the given structure has enough capacity
+ *              to hold the given number of items.
+ * \note        This macro computes the final capacity from the growth policy
+ *              first and then reallocates once.
+ * \param[in]   structure The structure to ensure capacity for.
+ * \param[in]   n The number of items the structure must be able to hold.
  */
-#define _reduce_cap(structure)                                                                    \
+#define _reserve_cap(structure, n)                                                                \
     {                                                                                             \
-        if ((structure)->size < (structure)->cap >> 2) {                                          \
-            (structure)->cap >>= 1;                                                               \
+        const size_t _reserve_n = (n);                                                            \
+        if ((structure)->cap < _reserve_n) {                                                      \
+            (structure)->cap =                                                                    \
+                _policy_grow_cap((structure)->policy, (structure)->cap, _reserve_n);              \
             (structure)->data =                                                                   \
                 (structure)->allocator->realloc((structure)->allocator->arena, (structure)->data, \
                                                 (structure)->cap * sizeof(*(structure)->data));   \
         }                                                                                         \
     }
 
+/**
+ * \brief       A macro ensuring that the given structure doesn't hold too much
+ *              unused capacity.
+ * \note        This macro halves the capacity of the structure if its size
+ *              dropped below the shrink threshold of its growth policy,
+ *              without going below the minimum capacity.
+ * \param[in]   structure The structure to reduce capacity for.
+ */
+#define _reduce_cap(structure)                                                  \
+    {                                                                           \
+        const struct hr_growth_policy_t *_policy = (structure)->policy;         \
+        if (!_policy->never_shrink && _policy->shrink_threshold > 0 &&          \
+            (structure)->size < (structure)->cap / _policy->shrink_threshold) { \
+            size_t _new_cap = (structure)->cap >> 1;                            \
+            if (_new_cap < _policy->min_cap)                                    \
+                _new_cap = _policy->min_cap;                                    \
+            if (_new_cap < (structure)->cap) {                                  \
+                (structure)->cap = _new_cap;                                    \
+                (structure)->data = (structure)->allocator->realloc(            \
+                    (structure)->allocator->arena, (structure)->data,           \
+                    (structure)->cap * sizeof(*(structure)->data));             \
+            }                                                                   \
+        }                                                                       \
+    }
+
+/**
+ * \brief       A macro ensuring that the given structure doesn't hold too much
+ *              unused capacity after many items were removed at once.
+ * \note        This macro halves the capacity the same way _reduce_cap does,
+ *              but keeps halving until the size is no longer below the shrink
+ *              threshold of the growth policy or the minimum capacity is
+ *              reached, and then reallocates once.
+ * \param[in]   structure The structure to reduce capacity for.
+ */
+#define _shrink_cap(structure)                                                   \
+    {                                                                            \
+        const struct hr_growth_policy_t *_sh_policy = (structure)->policy;       \
+        if (!_sh_policy->never_shrink && _sh_policy->shrink_threshold > 0) {     \
+            size_t _sh_cap = (structure)->cap;                                   \
+            while ((structure)->size < _sh_cap / _sh_policy->shrink_threshold) { \
+                size_t _sh_half = _sh_cap >> 1;                                  \
+                if (_sh_half < _sh_policy->min_cap)                              \
+                    _sh_half = _sh_policy->min_cap;                              \
+                if (_sh_half >= _sh_cap)                                         \
+                    break;                                                       \
+                _sh_cap = _sh_half;                                              \
+            }                                                                    \
+            if (_sh_cap < (structure)->cap) {                                    \
+                (structure)->cap = _sh_cap;                                      \
+                (structure)->data = (structure)->allocator->realloc(             \
+                    (structure)->allocator->arena, (structure)->data,            \
+                    (structure)->cap * sizeof(*(structure)->data));              \
+            }                                                                    \
+        }                                                                        \
+    }
+
+/**
+ * \brief       A macro for keeping only the items of an array that match a
+ *              predicate.
+ * \note        This macro compacts the matching items to the front of the
+ *              array in a single pass, keeping their order. Every item is
+ *              tested once and moved at most once.
+ * \param[in]   data The array to filter.
+ * \param[in]   size The size of the array.
+ * \param[in]   pred The predicate, called with a pointer to each item and
+ *              returning true for items to keep.
+ * \return      The number of items kept.
+ */
+#define _retain_items(data, size, pred)                     \
+    ({                                                      \
+        __auto_type _rt_data = (data);                      \
+        const size_t _rt_size = (size);                     \
+        size_t _rt_w = 0;                                   \
+        for (size_t _rt_r = 0; _rt_r < _rt_size; _rt_r++) { \
+            if (pred(&_rt_data[_rt_r])) {                   \
+                if (_rt_w != _rt_r)                         \
+                    _rt_data[_rt_w] = _rt_data[_rt_r];      \
+                _rt_w++;                                    \
+            }                                               \
+        }                                                   \
+        _rt_w;                                              \
+    })
+
+/**
+ * \brief       A macro for collapsing runs of equal items in an array.
+ * \note        This macro keeps the first item of every run of adjacent items
+ *              that compare equal, in a single pass. Sort the array first to
+ *              remove every duplicate.
+ * \param[in]   data The array to deduplicate.
+ * \param[in]   size The size of the array.
+ * \param[in]   cmp The comparison function for the items.
+ * \return      The number of items kept.
+ */
+#define _dedup_items(data, size, cmp)                             \
+    ({                                                            \
+        __auto_type _dd_data = (data);                            \
+        const size_t _dd_size = (size);                           \
+        size_t _dd_w = _dd_size > 0 ? 1 : 0;                      \
+        for (size_t _dd_r = 1; _dd_r < _dd_size; _dd_r++) {       \
+            if (cmp(_dd_data[_dd_w - 1], _dd_data[_dd_r]) != 0) { \
+                if (_dd_w != _dd_r)                               \
+                    _dd_data[_dd_w] = _dd_data[_dd_r];            \
+                _dd_w++;                                          \
+            }                                                     \
+        }                                                         \
+        _dd_w;                                                    \
+    })
+
 #define NULL_VAL(_val)                                                                   \
     _Generic((_val), bool                                                                \
              : false, char                                                               \
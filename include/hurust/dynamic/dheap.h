@@ -0,0 +1,331 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/*==========================================================================*
+
+  FILE
+    dheap.h
+
+  PROJECT
+    hurust generic library
+
+  DESCRIPTION
+    This file contains the d-ary heap implementation, a heap where every
+    node has a compile time number of children stored next to each other
+    and aligned to a cache line.
+
+  PROGRAMMER
+    Callum Gran.
+
+  MODIFICATIONS
+    18-Oct-26  C.Gran		Created file.
+
+ *==========================================================================*/
+#ifndef HURUST_DHEAP_H
+#define HURUST_DHEAP_H
+
+#include "../alloc.h"
+#include "../common.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * \brief     The alignment of the sibling groups of a d-ary heap.
+ */
+#define HR_DHEAP_ALIGN 64
+
+/**
+ * \brief     A macro for defining a d-ary heap.
+ * \note      This macro defines a d-ary heap with the given type, struct
+ *            prefix and arity. The children of item i are the items
+ *            i * arity + 1 to i * arity + arity, and the items are offset so
+ *            every such group starts on a cache line. When arity times the
+ *            size of the type is the cache line size, all the children of a
+ *            node are read with a single miss.
+ * \param[in] type The type of the heap.
+ * \param[in] struct_prefix The prefix for the heap struct.
+ * \param[in] arity The number of children of every node, at least 2.
+ * \note      The struct prefix parameter is used to define the heap struct
+ *            name as some types such as pointers and heaps cannot be used
+ *            as struct names.
+ */
+#define DHEAP(type, struct_prefix, arity)        \
+    typedef struct struct_prefix##_dheap_t {     \
+        type *data;                              \
+        void *raw;                               \
+        size_t offset;                           \
+        size_t size;                             \
+        size_t cap;                              \
+        int (*cmp)(const type, const type);      \
+        struct hr_allocator_t *allocator;        \
+        const struct hr_growth_policy_t *policy; \
+        char _arity[0][arity];                   \
+    } struct_prefix##_dheap_t;
+
+/**
+ * \brief     Internal macro for getting the arity of a d-ary heap.
+ * \param[in] _heap The heap to get the arity of.
+ * \note      This macro is internal and should not be used.
+ */
+#define _dheap_arity(_heap) (sizeof(*(_heap)->_arity))
+
+/**
+ * \brief     Internal macro for setting the capacity of a d-ary heap.
+ * \note      This macro reallocates the buffer of the heap and moves the
+ *            items if the new buffer needs another offset for the sibling
+ *            groups to stay aligned.
+ * \param[in] _heap The heap to set the capacity of.
+ * \param[in] _new_cap The new capacity of the heap.
+ * \note      This macro is internal and should not be used.
+ */
+#define _dheap_set_cap(_heap, _new_cap)                                                         \
+    ({                                                                                          \
+        const size_t _dh_item = sizeof(*(_heap)->data);                                         \
+        (_heap)->cap = (_new_cap);                                                              \
+        (_heap)->raw = HR_REALLOC((_heap)->allocator, (_heap)->raw,                             \
+                                  (_heap)->cap * _dh_item + HR_DHEAP_ALIGN);                    \
+        const uintptr_t _dh_first = ((uintptr_t)(_heap)->raw + _dh_item + HR_DHEAP_ALIGN - 1) & \
+                                    ~(uintptr_t)(HR_DHEAP_ALIGN - 1);                           \
+        const size_t _dh_offset = _dh_first - _dh_item - (uintptr_t)(_heap)->raw;               \
+        if (_dh_offset != (_heap)->offset)                                                      \
+            memmove((char *)(_heap)->raw + _dh_offset, (char *)(_heap)->raw + (_heap)->offset,  \
+                    (_heap)->size * _dh_item);                                                  \
+        (_heap)->offset = _dh_offset;                                                           \
+        (_heap)->data = (void *)((char *)(_heap)->raw + _dh_offset);                            \
+    })
+
+/**
+ * \brief     Internal macro for ensuring a d-ary heap can hold n items.
+ * \param[in] _heap The heap to ensure capacity for.
+ * \param[in] _n The number of items the heap must be able to hold.
+ * \note      This macro is internal and should not be used.
+ */
+#define _dheap_reserve(_heap, _n)                                                          \
+    ({                                                                                     \
+        const size_t _dr_n = (_n);                                                         \
+        if ((_heap)->cap < _dr_n)                                                          \
+            _dheap_set_cap(_heap, _policy_grow_cap((_heap)->policy, (_heap)->cap, _dr_n)); \
+    })
+
+/**
+ * \brief     Internal macro for moving an item of a d-ary heap up.
+ * \note      This macro lifts the item out, moves the parents above it down
+ *            into the hole it leaves and writes the item once at the end.
+ * \param[in] _heap The heap to heapify up.
+ * \param[in] _start The index of the item to move up.
+ * \note      This macro is internal and should not be used.
+ */
+#define _dheap_sift_up(_heap, _start)                                      \
+    ({                                                                     \
+        size_t _su_idx = (_start);                                         \
+        _typeofarray((_heap)->data) _su_item = (_heap)->data[_su_idx];     \
+        while (_su_idx > 0) {                                              \
+            const size_t _su_parent = (_su_idx - 1) / _dheap_arity(_heap); \
+            if ((_heap)->cmp(_su_item, (_heap)->data[_su_parent]) >= 0)    \
+                break;                                                     \
+            (_heap)->data[_su_idx] = (_heap)->data[_su_parent];            \
+            _su_idx = _su_parent;                                          \
+        }                                                                  \
+        (_heap)->data[_su_idx] = _su_item;                                 \
+    })
+
+/**
+ * \brief     Internal macro for moving an item of a d-ary heap down.
+ * \note      This macro lifts the item out, moves the best child up into
+ *            the hole it leaves as long as it should be above the item and
+ *            writes the item once at the end.
+ * \param[in] _heap The heap to heapify down.
+ * \param[in] _start The index of the item to move down.
+ * \note      This macro is internal and should not be used.
+ */
+#define _dheap_sift_down(_heap, _start)                                              \
+    ({                                                                               \
+        size_t _sd_idx = (_start);                                                   \
+        _typeofarray((_heap)->data) _sd_item = (_heap)->data[_sd_idx];               \
+        for (;;) {                                                                   \
+            const size_t _sd_first = _sd_idx * _dheap_arity(_heap) + 1;              \
+            if (_sd_first >= (_heap)->size)                                          \
+                break;                                                               \
+            size_t _sd_last = _sd_first + _dheap_arity(_heap);                       \
+            if (_sd_last > (_heap)->size)                                            \
+                _sd_last = (_heap)->size;                                            \
+            size_t _sd_best = _sd_first;                                             \
+            for (size_t _sd_c = _sd_first + 1; _sd_c < _sd_last; _sd_c++)            \
+                if ((_heap)->cmp((_heap)->data[_sd_c], (_heap)->data[_sd_best]) < 0) \
+                    _sd_best = _sd_c;                                                \
+            if ((_heap)->cmp((_heap)->data[_sd_best], _sd_item) >= 0)                \
+                break;                                                               \
+            (_heap)->data[_sd_idx] = (_heap)->data[_sd_best];                        \
+            _sd_idx = _sd_best;                                                      \
+        }                                                                            \
+        (_heap)->data[_sd_idx] = _sd_item;                                           \
+    })
+
+/**
+ * \brief     A macro for initializing a d-ary heap.
+ * \note      This macro initializes a d-ary heap with the given allocator,
+ *            capacity and comparison function for arranging the heap.
+ * \param[in] _heap The heap to initialize.
+ * \param[in] _allocator The allocator to use for the heap.
+ * \param[in] _cap The starting capacity of the heap.
+ * \param[in] _cmp The comparison function for arranging the heap.
+ */
+#define dheap_init(_heap, _allocator, _cap, _cmp)                    \
+    ({                                                               \
+        (_heap)->allocator = (_allocator);                           \
+        (_heap)->policy = HR_DEFAULT_GROWTH_POLICY;                  \
+        (_heap)->size = 0;                                           \
+        (_heap)->offset = 0;                                         \
+        (_heap)->cmp = (_cmp);                                       \
+        (_heap)->raw = HR_ALLOC((_heap)->allocator, HR_DHEAP_ALIGN); \
+        _dheap_set_cap(_heap, (_cap));                               \
+    })
+
+/**
+ * \brief     A macro for freeing a d-ary heap.
+ * \note      This macro frees a d-ary heap using the allocator specified
+ *            when initializing the heap.
+ * \param[in] _heap The heap to free.
+ */
+#define dheap_free(_heap) ({ HR_DEALLOC((_heap)->allocator, (_heap)->raw); })
+
+// Getters
+
+/**
+ * \brief     A macro for getting the size of a d-ary heap.
+ * \param[in] _heap The heap to get the size of.
+ */
+#define dheap_get_size(_heap) ({ (_heap)->size; })
+
+/**
+ * \brief     A macro for getting the capacity of a d-ary heap.
+ * \param[in] _heap The heap to get the capacity of.
+ */
+#define dheap_get_cap(_heap) ({ (_heap)->cap; })
+
+/**
+ * \brief     A macro for getting the data of a d-ary heap.
+ * \param[in] _heap The heap to get the data of.
+ */
+#define dheap_get_data(_heap) ({ (_heap)->data; })
+
+/**
+ * \brief     A macro for getting the arity of a d-ary heap.
+ * \param[in] _heap The heap to get the arity of.
+ */
+#define dheap_get_arity(_heap) ({ _dheap_arity(_heap); })
+
+/**
+ * \brief     A macro for getting the comparison function of a d-ary heap.
+ * \param[in] _heap The heap to get the comparison function of.
+ */
+#define dheap_get_cmp(_heap) ({ (_heap)->cmp; })
+
+// Setters
+
+/**
+ * \brief     A macro for setting the comparison function of a d-ary heap.
+ * \note      The heap is not rearranged, so this should only be done while
+ *            it is empty or when the order of the items is the same.
+ * \param[in] _heap The heap to set the comparison function of.
+ * \param[in] _cmp The comparison function to set the heap to.
+ */
+#define dheap_set_cmp(_heap, _cmp) ({ (_heap)->cmp = (_cmp); })
+
+/**
+ * \brief     A macro for setting the growth policy of a d-ary heap.
+ * \note      This macro sets the policy deciding how a d-ary heap grows and
+ *            shrinks. The policy is not copied and must outlive the heap.
+ * \param[in] _heap The heap to set the growth policy of.
+ * \param[in] _policy The growth policy to set the heap to.
+ */
+#define dheap_set_policy(_heap, _policy) ({ (_heap)->policy = (_policy); })
+
+/**
+ * \brief     A macro for checking if a d-ary heap is empty.
+ * \param[in] _heap The heap to check.
+ */
+#define dheap_empty(_heap) ({ (_heap)->size == 0; })
+
+/**
+ * \brief     A macro for pushing an item to a d-ary heap.
+ * \note      This macro pushes an item to a d-ary heap and moves it up to
+ *            its place.
+ * \param[in] _heap The heap to push the item to.
+ * \param[in] _item The item to push to the heap.
+ */
+#define dheap_push(_heap, _item)                   \
+    ({                                             \
+        _dheap_reserve(_heap, (_heap)->size + 1);  \
+        (_heap)->data[(_heap)->size++] = *(_item); \
+        _dheap_sift_up(_heap, (_heap)->size - 1);  \
+    })
+
+/**
+ * \brief     A macro for building a d-ary heap from an array.
+ * \note      This macro replaces the items of a d-ary heap with a copy of
+ *            the given array and arranges them in O(n) time.
+ * \param[in] _heap The heap to build.
+ * \param[in] _arr The array of items to copy into the heap.
+ * \param[in] _n The number of items in the array.
+ */
+#define dheap_from_array(_heap, _arr, _n)                                          \
+    ({                                                                             \
+        const size_t _fa_n = (_n);                                                 \
+        (_heap)->size = 0;                                                         \
+        _dheap_reserve(_heap, _fa_n);                                              \
+        memcpy((_heap)->data, (_arr), sizeof(*(_heap)->data) * _fa_n);             \
+        (_heap)->size = _fa_n;                                                     \
+        for (size_t _fa_i = _fa_n > 1 ? (_fa_n - 2) / _dheap_arity(_heap) + 1 : 0; \
+             _fa_i > 0; _fa_i--)                                                   \
+            _dheap_sift_down(_heap, _fa_i - 1);                                    \
+    })
+
+/**
+ * \brief     A macro for popping an item from a d-ary heap.
+ * \note      This macro pops the front item from a d-ary heap, moves the
+ *            last item down from the root to its place and shrinks the heap
+ *            if the growth policy says so.
+ * \param[in] _heap The heap to pop the item from.
+ */
+#define dheap_pop(_heap)                                                     \
+    ({                                                                       \
+        _typeofarray((_heap)->data) _ret = (_heap)->data[0];                 \
+        if (--(_heap)->size > 0) {                                           \
+            (_heap)->data[0] = (_heap)->data[(_heap)->size];                 \
+            _dheap_sift_down(_heap, 0);                                      \
+        }                                                                    \
+        const struct hr_growth_policy_t *_dp_policy = (_heap)->policy;       \
+        if (!_dp_policy->never_shrink && _dp_policy->shrink_threshold > 0 && \
+            (_heap)->size < (_heap)->cap / _dp_policy->shrink_threshold) {   \
+            size_t _dp_cap = (_heap)->cap >> 1;                              \
+            if (_dp_cap < _dp_policy->min_cap)                               \
+                _dp_cap = _dp_policy->min_cap;                               \
+            if (_dp_cap < (_heap)->cap)                                      \
+                _dheap_set_cap(_heap, _dp_cap);                              \
+        }                                                                    \
+        _ret;                                                                \
+    })
+
+/**
+ * \brief     A macro for getting the item at the front of a d-ary heap.
+ * \note      This macro does not pop the item from the heap.
+ * \param[in] _heap The heap to get the item from.
+ */
+#define dheap_peek(_heap) ({ (_heap)->data[0]; })
+
+#endif // HURUST_DHEAP_H
@@ -40,6 +40,7 @@
 #include "../common.h"
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 /**
  * \brief     A macro for defining a queue.
@@ -50,14 +51,15 @@
  *            name as some types such as pointers and arrays cannot be used
  *            as struct names.
  */
-#define DQUEUE(type, struct_prefix)           \
-    typedef struct struct_prefix##_dqueue_t { \
-        type *data;                           \
-        size_t start;                         \
-        size_t end;                           \
-        size_t size;                          \
-        size_t cap;                           \
-        struct hr_allocator_t *allocator;     \
+#define DQUEUE(type, struct_prefix)              \
+    typedef struct struct_prefix##_dqueue_t {    \
+        type *data;                              \
+        size_t start;                            \
+        size_t end;                              \
+        size_t size;                             \
+        size_t cap;                              \
+        struct hr_allocator_t *allocator;        \
+        const struct hr_growth_policy_t *policy; \
     } struct_prefix##_dqueue_t;
 
 /**
@@ -71,6 +73,7 @@
 #define dqueue_init(_queue, _allocator, _cap)                                                    \
     ({                                                                                           \
         (_queue)->allocator = (_allocator);                                                      \
+        (_queue)->policy = HR_DEFAULT_GROWTH_POLICY;                                             \
         (_queue)->cap = (_cap);                                                                  \
         (_queue)->size = 0;                                                                      \
         (_queue)->start = 0;                                                                     \
@@ -116,6 +119,13 @@
  */
 #define dqueue_get_allocator(_queue) ({ (_queue)->allocator; })
 
+/**
+ * \brief     A macro for getting the growth policy of a queue.
+ * \note      This macro gets the growth policy of a queue.
+ * \param[in] _queue The queue to get the growth policy of.
+ */
+#define dqueue_get_policy(_queue) ({ (_queue)->policy; })
+
 /**
  * \brief     A macro for getting the start of a queue.
  * \note      This macro gets the start of a queue.
@@ -164,6 +174,15 @@
  */
 #define dqueue_set_allocator(_queue, _allocator) ({ (_queue)->allocator = (_allocator); })
 
+/**
+ * \brief     A macro for setting the growth policy of a queue.
+ * \note      This macro sets the policy deciding how a queue grows.
+ *            The policy is not copied and must outlive the queue.
+ * \param[in] _queue The queue to set the growth policy of.
+ * \param[in] _policy The growth policy to set the queue to.
+ */
+#define dqueue_set_policy(_queue, _policy) ({ (_queue)->policy = (_policy); })
+
 /**
  * \brief     A macro for setting the start of a queue.
  * \note      This macro sets the start of a queue.
@@ -205,29 +224,63 @@
         _ret;                                                                \
     })
 
+/**
+ * \brief     Internal macro for ensuring a queue has room for another item.
+ * \note      When the queue is full it grows by its growth policy, and the
+ *            wrapped around part of the buffer is moved to the end of the
+ *            new buffer.
+ * \param[in] _queue The queue to ensure capacity for.
+ * \note      This macro is internal and should not be used.
+ */
+#define _dqueue_ensure_cap(_queue)                                                                \
+    ({                                                                                            \
+        if ((_queue)->size == (_queue)->cap) {                                                    \
+            const size_t _old_cap = (_queue)->cap;                                                \
+            (_queue)->cap = _policy_grow_cap((_queue)->policy, _old_cap, (_queue)->size + 1);     \
+            (_queue)->data = HR_REALLOC((_queue)->allocator, (_queue)->data,                      \
+                                        sizeof(*(_queue)->data) * (_queue)->cap);                 \
+            if ((_queue)->start == 0) {                                                           \
+                (_queue)->end = (_queue)->size;                                                   \
+            } else {                                                                              \
+                const size_t _tail = _old_cap - (_queue)->start;                                  \
+                memmove((_queue)->data + (_queue)->cap - _tail, (_queue)->data + (_queue)->start, \
+                        sizeof(*(_queue)->data) * _tail);                                         \
+                (_queue)->start = (_queue)->cap - _tail;                                          \
+            }                                                                                     \
+        }                                                                                         \
+    })
+
 /**
  * \brief     A macro for pushing an item to a queue.
- * \note      This macro pushes an item to a queue.
+ * \note      This macro pushes an item to a queue, growing it by its growth
+ *            policy when it is full.
  * \param[in] _queue The queue to push to.
  * \param[in] _item The item to push.
  */
-#define dqueue_push(_queue, _item)                                                \
-    ({                                                                            \
-        if ((_queue)->size == (_queue)->cap) {                                    \
-            (_queue)->cap *= 2;                                                   \
-            (_queue)->data = HR_REALLOC((_queue)->allocator, (_queue)->data,      \
-                                        sizeof(*(_queue)->data) * (_queue)->cap); \
-            if ((_queue)->start >= (_queue)->end) {                               \
-                size_t i = 0;                                                     \
-                for (i = 0; i < (_queue)->end; i++) {                             \
-                    (_queue)->data[i + (_queue)->size] = (_queue)->data[i];       \
-                }                                                                 \
-                (_queue)->end += (_queue)->size;                                  \
-            }                                                                     \
-        }                                                                         \
-        (_queue)->data[(_queue)->end] = *(_item);                                 \
-        (_queue)->end = ((_queue)->end + 1) % (_queue)->cap;                      \
-        (_queue)->size++;                                                         \
+#define dqueue_push(_queue, _item)                           \
+    ({                                                       \
+        _dqueue_ensure_cap(_queue);                          \
+        (_queue)->data[(_queue)->end] = *(_item);            \
+        (_queue)->end = ((_queue)->end + 1) % (_queue)->cap; \
+        (_queue)->size++;                                    \
+    })
+
+/**
+ * \brief     A macro for emplacing an item at the back of a queue.
+ * \note      This macro grows the queue if needed, adds an uninitialised
+ *            slot at the back and returns a pointer to it, so the item can
+ *            be constructed in place instead of being copied in. The slot
+ *            must be written before the queue is used again.
+ * \param[in] _queue The queue to emplace the item in.
+ * \return    A pointer to the new slot.
+ */
+#define dqueue_emplace(_queue)                                      \
+    ({                                                              \
+        _dqueue_ensure_cap(_queue);                                 \
+        __auto_type _emplace_slot = (_queue)->data + (_queue)->end; \
+        (_queue)->end = ((_queue)->end + 1) % (_queue)->cap;        \
+        (_queue)->size++;                                           \
+        _emplace_slot;                                              \
     })
 
 /**
@@ -49,12 +49,13 @@
  *            name as some types such as pointers and arrays cannot be used
  *            as struct names.
  */
-#define DSTACK(type, struct_prefix)           \
-    typedef struct struct_prefix##_dstack_t { \
-        type *data;                           \
-        size_t size;                          \
-        size_t cap;                           \
-        struct hr_allocator_t *allocator;     \
+#define DSTACK(type, struct_prefix)              \
+    typedef struct struct_prefix##_dstack_t {    \
+        type *data;                              \
+        size_t size;                             \
+        size_t cap;                              \
+        struct hr_allocator_t *allocator;        \
+        const struct hr_growth_policy_t *policy; \
     } struct_prefix##_dstack_t;
 
 /**
@@ -68,6 +69,7 @@
 #define dstack_init(_stack, _allocator, _cap)                                                    \
     ({                                                                                           \
         (_stack)->allocator = (_allocator);                                                      \
+        (_stack)->policy = HR_DEFAULT_GROWTH_POLICY;                                             \
         (_stack)->cap = (_cap);                                                                  \
         (_stack)->size = 0;                                                                      \
         (_stack)->data = HR_ALLOC((_stack)->allocator, sizeof(*(_stack)->data) * (_stack)->cap); \
@@ -111,6 +113,13 @@
  */
 #define dstack_get_allocator(_stack) ({ (_stack)->allocator; })
 
+/**
+ * \brief     A macro for getting the growth policy of a stack.
+ * \note      This macro gets the growth policy of a stack.
+ * \param[in] _stack The stack to get the growth policy of.
+ */
+#define dstack_get_policy(_stack) ({ (_stack)->policy; })
+
 // Setters
 
 /**
@@ -145,6 +154,15 @@
  */
 #define dstack_set_allocator(_stack, _allocator) ({ (_stack)->allocator = (_allocator); })
 
+/**
+ * \brief     A macro for setting the growth policy of a stack.
+ * \note      This macro sets the policy deciding how a stack grows and
+ *            shrinks. The policy is not copied and must outlive the stack.
+ * \param[in] _stack The stack to set the growth policy of.
+ * \param[in] _policy The growth policy to set the stack to.
+ */
+#define dstack_set_policy(_stack, _policy) ({ (_stack)->policy = (_policy); })
+
 /**
  * \brief     A macro for checking if a stack is empty.
  * \note      This macro checks if a stack is empty.
@@ -183,6 +201,21 @@
         (_stack)->size++;                          \
     })
 
+/**
+ * \brief     A macro for emplacing an item on top of a stack.
+ * \note      This macro grows the stack if needed, adds an uninitialised
+ *            slot on top and returns a pointer to it, so the item can be
+ *            constructed in place instead of being copied in. The slot must
+ *            be written before the stack is used again.
+ * \param[in] _stack The stack to emplace the item on.
+ * \return    A pointer to the new slot.
+ */
+#define dstack_emplace(_stack)             \
+    ({                                     \
+        _ensure_cap((_stack));             \
+        &(_stack)->data[(_stack)->size++]; \
+    })
+
 /**
  * \brief     A macro for getting the item at the front of a stack.
  * \note      This macro gets an item from a stack and stores it in the
@@ -39,6 +39,7 @@
 #include "../common.h"
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 /**
  * \brief     A macro for defining an heap.
@@ -49,13 +50,14 @@
  *            name as some types such as pointers and heaps cannot be used
  *            as struct names.
  */
-#define HEAP(type, struct_prefix)           \
-    typedef struct struct_prefix##_heap_t { \
-        type *data;                         \
-        size_t size;                        \
-        size_t cap;                         \
-        int (*cmp)(const type, const type); \
-        struct hr_allocator_t *allocator;   \
+#define HEAP(type, struct_prefix)                \
+    typedef struct struct_prefix##_heap_t {      \
+        type *data;                              \
+        size_t size;                             \
+        size_t cap;                              \
+        int (*cmp)(const type, const type);      \
+        struct hr_allocator_t *allocator;        \
+        const struct hr_growth_policy_t *policy; \
     } struct_prefix##_heap_t;
 
 /**
@@ -70,6 +72,7 @@
 #define heap_init(_heap, _allocator, _cap, _cmp)                                             \
     ({                                                                                       \
         (_heap)->allocator = (_allocator);                                                   \
+        (_heap)->policy = HR_DEFAULT_GROWTH_POLICY;                                          \
         (_heap)->cap = (_cap);                                                               \
         (_heap)->size = 0;                                                                   \
         (_heap)->cmp = (_cmp);                                                               \
@@ -100,48 +103,83 @@
 
 #define heap_parent(_heap, _child_idx) ((_heap)->data[_heap_parent_idx(_child_idx)])
 
+/**
+ * \brief     Internal function for heapifying up a heap from an index.
+ * \note      This function lifts the item at the given index out, moves the
+ *            parents that should be below it down into the hole it leaves
+ *            and writes the item once where the hole stops.
+ * \param[in] _heap The heap to heapify up.
+ * \param[in] _start The index of the item to move up.
+ * \note      This function is internal and should not be used.
+ */
+#define _heapify_up_from(_heap, _start)                                    \
+    ({                                                                     \
+        __ssize_t _idx = (_start);                                         \
+        _typeofarray((_heap)->data) _hole_item = (_heap)->data[_idx];      \
+        while (_idx > 0) {                                                 \
+            __ssize_t _parent_idx = _heap_parent_idx(_idx);                \
+            if ((_heap)->cmp(_hole_item, (_heap)->data[_parent_idx]) >= 0) \
+                break;                                                     \
+            (_heap)->data[_idx] = (_heap)->data[_parent_idx];              \
+            _idx = _parent_idx;                                            \
+        }                                                                  \
+        (_heap)->data[_idx] = _hole_item;                                  \
+    })
+
 /**
  * \brief     Internal function for heapifying up a heap.
- * \note      This function heapifies up a heap.
+ * \note      This function heapifies up the last item of a heap.
  * \param[in] _heap The heap to heapify up.
  * \note      This function is internal and should not be used.
  */
-#define _heapify_up(_heap)                                                            \
-    ({                                                                                \
-        __ssize_t _idx = (_heap)->size - 1;                                           \
-        __ssize_t _parent_idx = _heap_parent_idx(_idx);                               \
-        while (_parent_idx >= 0 &&                                                    \
-               (_heap)->cmp(((_heap)->data[_idx]), (_heap)->data[_parent_idx]) < 0) { \
-            swap(_typeofarray((_heap)->data), ((_heap)->data + _parent_idx),          \
-                 ((_heap)->data + _idx));                                             \
-            _idx = _parent_idx;                                                       \
-            _parent_idx = _heap_parent_idx(_idx);                                     \
-        }                                                                             \
+#define _heapify_up(_heap) _heapify_up_from(_heap, (__ssize_t)(_heap)->size - 1)
+
+/**
+ * \brief     Internal function for heapifying down a heap from an index.
+ * \note      This function lifts the item at the given index out, moves the
+ *            smallest child up into the hole it leaves as long as it should
+ *            be above the item and writes the item once where the hole stops.
+ * \param[in] _heap The heap to heapify down.
+ * \param[in] _start The index of the item to move down.
+ * \note      This function is internal and should not be used.
+ */
+#define _heapify_down_from(_heap, _start)                                                      \
+    ({                                                                                         \
+        __ssize_t _idx = (_start);                                                             \
+        __ssize_t _min_idx;                                                                    \
+        _typeofarray((_heap)->data) _hole_item = (_heap)->data[_idx];                          \
+        while (_heap_has_left_child(_heap, _idx)) {                                            \
+            _min_idx = _heap_left_child_idx(_idx);                                             \
+            if (_heap_has_right_child(_heap, _idx) &&                                          \
+                (_heap)->cmp(heap_right_child(_heap, _idx), heap_left_child(_heap, _idx)) < 0) \
+                _min_idx = _heap_right_child_idx(_idx);                                        \
+            if ((_heap)->cmp((_heap)->data[_min_idx], _hole_item) >= 0)                        \
+                break;                                                                         \
+            (_heap)->data[_idx] = (_heap)->data[_min_idx];                                     \
+            _idx = _min_idx;                                                                   \
+        }                                                                                      \
+        (_heap)->data[_idx] = _hole_item;                                                      \
     })
 
 /**
  * \brief     Internal function for heapifying down a heap.
- * \note      This function heapifies down a heap.
+ * \note      This function heapifies down a heap from the root.
  * \param[in] _heap The heap to heapify down.
  * \note      This function is internal and should not be used.
  */
-#define _heapify_down(_heap)                                                                       \
-    ({                                                                                             \
-        __ssize_t _idx = 0;                                                                        \
-        __ssize_t _min_idx;                                                                        \
-        while (_heap_has_left_child(_heap, _idx)) {                                                \
-            _min_idx = _heap_left_child_idx(_idx);                                                 \
-            if (_heap_has_right_child(_heap, _idx) &&                                              \
-                (_heap)->cmp(heap_right_child(_heap, _idx), heap_left_child(_heap, _idx)) < 0) {   \
-                _min_idx = _heap_right_child_idx(_idx);                                            \
-            }                                                                                      \
-            if ((_heap)->cmp(((_heap)->data[_min_idx]), (_heap)->data[_idx]) > 0) {                \
-                break;                                                                             \
-            } else {                                                                               \
-                swap(_typeofarray((_heap)->data), (_heap)->data + _idx, (_heap)->data + _min_idx); \
-                _idx = _min_idx;                                                                   \
-            }                                                                                      \
-        }                                                                                          \
+#define _heapify_down(_heap) _heapify_down_from(_heap, 0)
+
+/**
+ * \brief     Internal function for turning the items of a heap into a heap.
+ * \note      This function uses Floyd's method, heapifying down every parent
+ *            from the last one to the root, which takes O(n) time.
+ * \param[in] _heap The heap to heapify.
+ * \note      This function is internal and should not be used.
+ */
+#define _heapify(_heap)                                            \
+    ({                                                             \
+        for (size_t _hf_i = (_heap)->size / 2; _hf_i > 0; _hf_i--) \
+            _heapify_down_from(_heap, _hf_i - 1);                  \
     })
 
 // Getters
@@ -181,6 +219,13 @@
  */
 #define heap_get_allocator(_heap) ({ (_heap)->cmp; })
 
+/**
+ * \brief     A macro for getting the growth policy of a heap.
+ * \note      This macro gets the growth policy of a heap.
+ * \param[in] _heap The heap to get the growth policy of.
+ */
+#define heap_get_policy(_heap) ({ (_heap)->policy; })
+
 // Setters
 
 /**
@@ -223,6 +268,15 @@
  */
 #define heap_set_allocator(_heap, _allocator) ({ (_heap)->allocator = (_allocator); })
 
+/**
+ * \brief     A macro for setting the growth policy of a heap.
+ * \note      This macro sets the policy deciding how a heap grows and
+ *            shrinks. The policy is not copied and must outlive the heap.
+ * \param[in] _heap The heap to set the growth policy of.
+ * \param[in] _policy The growth policy to set the heap to.
+ */
+#define heap_set_policy(_heap, _policy) ({ (_heap)->policy = (_policy); })
+
 /**
  * \brief     A macro for checking if a heap is empty.
  * \note      This macro checks if a heap is empty.
@@ -244,6 +298,76 @@
         _heapify_up(_heap);                        \
     })
 
+/**
+ * \brief     A macro for building a heap from an array.
+ * \note      This macro replaces the items of a heap with a copy of the
+ *            given array and arranges them in O(n) time, which is faster than
+ *            pushing the items one by one.
+ * \param[in] _heap The heap to build.
+ * \param[in] _arr The array of items to copy into the heap.
+ * \param[in] _n The number of items in the array.
+ */
+#define heap_from_array(_heap, _arr, _n)                               \
+    ({                                                                 \
+        const size_t _fa_n = (_n);                                     \
+        (_heap)->size = 0;                                             \
+        _reserve_cap(_heap, _fa_n);                                    \
+        memcpy((_heap)->data, (_arr), sizeof(*(_heap)->data) * _fa_n); \
+        (_heap)->size = _fa_n;                                         \
+        _heapify(_heap);                                               \
+    })
+
+/**
+ * \brief     A macro for pushing many items to a heap.
+ * \note      This macro reserves room for all the items at once and copies
+ *            them in. When the new items are a large part of the heap it is
+ *            rebuilt in O(n) time, otherwise each new item is moved up on
+ *            its own.
+ * \param[in] _heap The heap to push the items to.
+ * \param[in] _arr The array of items to push.
+ * \param[in] _n The number of items in the array.
+ */
+#define heap_push_bulk(_heap, _arr, _n)                                          \
+    ({                                                                           \
+        const size_t _pb_n = (_n);                                               \
+        const size_t _pb_old = (_heap)->size;                                    \
+        _reserve_cap(_heap, _pb_old + _pb_n);                                    \
+        memcpy((_heap)->data + _pb_old, (_arr), sizeof(*(_heap)->data) * _pb_n); \
+        if (_pb_n > _pb_old / 8) {                                               \
+            (_heap)->size = _pb_old + _pb_n;                                     \
+            _heapify(_heap);                                                     \
+        } else {                                                                 \
+            for (size_t _pb_i = 0; _pb_i < _pb_n; _pb_i++) {                     \
+                (_heap)->size++;                                                 \
+                _heapify_up(_heap);                                              \
+            }                                                                    \
+        }                                                                        \
+    })
+
+/**
+ * \brief     A macro for emplacing an item in a heap.
+ * \note      This macro grows the heap if needed, adds an uninitialised slot
+ *            at the bottom and returns a pointer to it, so the item can be
+ *            constructed in place instead of being copied in. The heap is
+ *            not valid until heap_emplace_commit has been called after the
+ *            slot has been written.
+ * \param[in] _heap The heap to emplace the item in.
+ * \return    A pointer to the new slot.
+ */
+#define heap_emplace(_heap)              \
+    ({                                   \
+        _ensure_cap(_heap);              \
+        &(_heap)->data[(_heap)->size++]; \
+    })
+
+/**
+ * \brief     A macro for moving an emplaced item to its place in a heap.
+ * \note      This macro must be called once after every heap_emplace, when
+ *            the slot has been written.
+ * \param[in] _heap The heap to commit the emplaced item of.
+ */
+#define heap_emplace_commit(_heap) ({ _heapify_up(_heap); })
+
 /**
  * \brief     A macro for popping an item from a heap.
  * \note      This macro pops an item from a heap,
@@ -260,6 +384,76 @@
         _ret;                                                \
     })
 
+/**
+ * \brief     A macro for popping an item from a heap bottom up.
+ * \note      This macro pops an item from a heap like heap_pop, but moves
+ *            the hole left by the front item down to a leaf with one
+ *            comparison per level and then moves the last item up from
+ *            there. As the last item usually belongs near the bottom this
+ *            uses close to half the comparisons of heap_pop, which pays off
+ *            when the comparison function is expensive.
+ * \param[in] _heap The heap to pop the item from.
+ */
+#define heap_pop_bottom_up(_heap)                                                             \
+    ({                                                                                        \
+        _typeofarray((_heap)->data) _ret = (_heap)->data[0];                                  \
+        const __ssize_t _bu_last = --(_heap)->size;                                           \
+        if (_bu_last > 0) {                                                                   \
+            __ssize_t _bu_idx = 0;                                                            \
+            __ssize_t _bu_child;                                                              \
+            while ((_bu_child = _heap_left_child_idx(_bu_idx)) < _bu_last) {                  \
+                if (_bu_child + 1 < _bu_last &&                                               \
+                    (_heap)->cmp((_heap)->data[_bu_child + 1], (_heap)->data[_bu_child]) < 0) \
+                    _bu_child++;                                                              \
+                (_heap)->data[_bu_idx] = (_heap)->data[_bu_child];                            \
+                _bu_idx = _bu_child;                                                          \
+            }                                                                                 \
+            (_heap)->data[_bu_idx] = (_heap)->data[_bu_last];                                 \
+            _heapify_up_from(_heap, _bu_idx);                                                 \
+        }                                                                                     \
+        _reduce_cap(_heap);                                                                   \
+        _ret;                                                                                 \
+    })
+
+/**
+ * \brief     A macro for pushing an item to a heap and then popping one.
+ * \note      This macro does the same as heap_push followed by heap_pop
+ *            with a single heapify down. If the item would be the front of
+ *            the heap it is returned straight away without touching the
+ *            heap.
+ * \param[in] _heap The heap to push the item to.
+ * \param[in] _item The item to push to the heap.
+ * \return    The front item of the heap with the item pushed.
+ */
+#define heap_pushpop(_heap, _item)                                           \
+    ({                                                                       \
+        _typeofarray((_heap)->data) _ret = *(_item);                         \
+        if ((_heap)->size > 0 && (_heap)->cmp((_heap)->data[0], _ret) < 0) { \
+            _typeofarray((_heap)->data) _pp_front = (_heap)->data[0];        \
+            (_heap)->data[0] = _ret;                                         \
+            _heapify_down(_heap);                                            \
+            _ret = _pp_front;                                                \
+        }                                                                    \
+        _ret;                                                                \
+    })
+
+/**
+ * \brief     A macro for popping an item from a heap and then pushing one.
+ * \note      This macro does the same as heap_pop followed by heap_push
+ *            with a single heapify down, by putting the item in the place
+ *            of the front item. The heap must not be empty.
+ * \param[in] _heap The heap to pop the item from.
+ * \param[in] _item The item to push to the heap.
+ * \return    The front item of the heap before the item was pushed.
+ */
+#define heap_replace(_heap, _item)                           \
+    ({                                                       \
+        _typeofarray((_heap)->data) _ret = (_heap)->data[0]; \
+        (_heap)->data[0] = *(_item);                         \
+        _heapify_down(_heap);                                \
+        _ret;                                                \
+    })
+
 /**
  * \brief     A macro for getting the item at the front of a heap.
  * \note      This macro gets the item at the front of a heap.
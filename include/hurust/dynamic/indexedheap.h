@@ -0,0 +1,379 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/*==========================================================================*
+
+  FILE
+    indexedheap.h
+
+  PROJECT
+    hurust generic library
+
+  DESCRIPTION
+    This file contains the indexed binary heap implementation, a priority
+    queue that hands out a stable handle for every pushed item so the item
+    can later be changed or removed in O(log n) time.
+
+  PROGRAMMER
+    Callum Gran.
+
+  MODIFICATIONS
+    18-Oct-26  C.Gran		Created file.
+
+ *==========================================================================*/
+#ifndef HURUST_INDEXED_HEAP_H
+#define HURUST_INDEXED_HEAP_H
+
+#include "../alloc.h"
+#include "../common.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \brief     A macro for defining an indexed heap.
+ * \note      This macro defines an indexed heap with the given type and
+ *            struct prefix. The items are stored by handle and the heap
+ *            itself only moves handles around, with a position map from
+ *            every handle to its place in the heap. The handles after the
+ *            size of the heap are the free ones, which are reused by the
+ *            next pushes.
+ * \param[in] type The type of the indexed heap.
+ * \param[in] struct_prefix The prefix for the indexed heap struct.
+ * \note      The struct prefix parameter is used to define the indexed heap
+ *            struct name as some types such as pointers and heaps cannot be
+ *            used as struct names.
+ */
+#define INDEXED_HEAP(type, struct_prefix)           \
+    typedef struct struct_prefix##_indexed_heap_t { \
+        type *items;                                \
+        size_t *handles;                            \
+        size_t *pos;                                \
+        size_t size;                                \
+        size_t used;                                \
+        size_t cap;                                 \
+        int (*cmp)(const type, const type);         \
+        struct hr_allocator_t *allocator;           \
+        const struct hr_growth_policy_t *policy;    \
+    } struct_prefix##_indexed_heap_t;
+
+/**
+ * \brief     Internal macro for setting the capacity of an indexed heap.
+ * \param[in] _heap The heap to set the capacity of.
+ * \param[in] _new_cap The new capacity of the heap.
+ * \note      This macro is internal and should not be used.
+ */
+#define _indexed_heap_set_cap(_heap, _new_cap)                                                  \
+    ({                                                                                          \
+        (_heap)->cap = (_new_cap);                                                              \
+        (_heap)->items = HR_REALLOC((_heap)->allocator, (_heap)->items,                         \
+                                    sizeof(*(_heap)->items) * (_heap)->cap);                    \
+        (_heap)->handles = HR_REALLOC((_heap)->allocator, (_heap)->handles,                     \
+                                      sizeof(*(_heap)->handles) * (_heap)->cap);                \
+        (_heap)->pos =                                                                          \
+            HR_REALLOC((_heap)->allocator, (_heap)->pos, sizeof(*(_heap)->pos) * (_heap)->cap); \
+    })
+
+/**
+ * \brief     Internal macro for moving a handle of an indexed heap up.
+ * \note      This macro lifts the handle out, moves the parents that should
+ *            be below it down into the hole it leaves and writes it once
+ *            where the hole stops, keeping the position map up to date.
+ * \param[in] _heap The heap to heapify up.
+ * \param[in] _start The heap index of the handle to move up.
+ * \return    The heap index the handle ended up at.
+ * \note      This macro is internal and should not be used.
+ */
+#define _indexed_heap_sift_up(_heap, _start)                                                      \
+    ({                                                                                            \
+        size_t _su_idx = (_start);                                                                \
+        const size_t _su_handle = (_heap)->handles[_su_idx];                                      \
+        while (_su_idx > 0) {                                                                     \
+            const size_t _su_parent = (_su_idx - 1) >> 1;                                         \
+            const size_t _su_parent_handle = (_heap)->handles[_su_parent];                        \
+            if ((_heap)->cmp((_heap)->items[_su_handle], (_heap)->items[_su_parent_handle]) >= 0) \
+                break;                                                                            \
+            (_heap)->handles[_su_idx] = _su_parent_handle;                                        \
+            (_heap)->pos[_su_parent_handle] = _su_idx;                                            \
+            _su_idx = _su_parent;                                                                 \
+        }                                                                                         \
+        (_heap)->handles[_su_idx] = _su_handle;                                                   \
+        (_heap)->pos[_su_handle] = _su_idx;                                                       \
+        _su_idx;                                                                                  \
+    })
+
+/**
+ * \brief     Internal macro for moving a handle of an indexed heap down.
+ * \note      This macro lifts the handle out, moves the smallest child up
+ *            into the hole it leaves as long as it should be above it and
+ *            writes it once where the hole stops, keeping the position map
+ *            up to date.
+ * \param[in] _heap The heap to heapify down.
+ * \param[in] _start The heap index of the handle to move down.
+ * \note      This macro is internal and should not be used.
+ */
+#define _indexed_heap_sift_down(_heap, _start)                                                   \
+    ({                                                                                           \
+        size_t _sd_idx = (_start);                                                               \
+        const size_t _sd_handle = (_heap)->handles[_sd_idx];                                     \
+        size_t _sd_child;                                                                        \
+        while ((_sd_child = (_sd_idx << 1) + 1) < (_heap)->size) {                               \
+            if (_sd_child + 1 < (_heap)->size &&                                                 \
+                (_heap)->cmp((_heap)->items[(_heap)->handles[_sd_child + 1]],                    \
+                             (_heap)->items[(_heap)->handles[_sd_child]]) < 0)                   \
+                _sd_child++;                                                                     \
+            const size_t _sd_child_handle = (_heap)->handles[_sd_child];                         \
+            if ((_heap)->cmp((_heap)->items[_sd_child_handle], (_heap)->items[_sd_handle]) >= 0) \
+                break;                                                                           \
+            (_heap)->handles[_sd_idx] = _sd_child_handle;                                        \
+            (_heap)->pos[_sd_child_handle] = _sd_idx;                                            \
+            _sd_idx = _sd_child;                                                                 \
+        }                                                                                        \
+        (_heap)->handles[_sd_idx] = _sd_handle;                                                  \
+        (_heap)->pos[_sd_handle] = _sd_idx;                                                      \
+    })
+
+/**
+ * \brief     Internal macro for taking a handle out of an indexed heap.
+ * \note      This macro swaps the handle with the last one in the heap,
+ *            shrinks the heap so the handle becomes free and moves the
+ *            handle that took its place to where it belongs.
+ * \param[in] _heap The heap to take the handle out of.
+ * \param[in] _handle The handle to take out.
+ * \note      This macro is internal and should not be used.
+ */
+#define _indexed_heap_unlink(_heap, _handle)                                        \
+    ({                                                                              \
+        const size_t _ul_handle = (_handle);                                        \
+        const size_t _ul_idx = (_heap)->pos[_ul_handle];                            \
+        const size_t _ul_last = --(_heap)->size;                                    \
+        const size_t _ul_last_handle = (_heap)->handles[_ul_last];                  \
+        (_heap)->handles[_ul_idx] = _ul_last_handle;                                \
+        (_heap)->pos[_ul_last_handle] = _ul_idx;                                    \
+        (_heap)->handles[_ul_last] = _ul_handle;                                    \
+        (_heap)->pos[_ul_handle] = _ul_last;                                        \
+        if (_ul_idx < _ul_last && _indexed_heap_sift_up(_heap, _ul_idx) == _ul_idx) \
+            _indexed_heap_sift_down(_heap, _ul_idx);                                \
+    })
+
+/**
+ * \brief     A macro for initializing an indexed heap.
+ * \note      This macro initializes an indexed heap with the given
+ *            allocator, capacity and comparison function for arranging the
+ *            heap.
+ * \param[in] _heap The heap to initialize.
+ * \param[in] _allocator The allocator to use for the heap.
+ * \param[in] _cap The starting capacity of the heap.
+ * \param[in] _cmp The comparison function for arranging the heap.
+ */
+#define indexed_heap_init(_heap, _allocator, _cap, _cmp)                                       \
+    ({                                                                                         \
+        (_heap)->allocator = (_allocator);                                                     \
+        (_heap)->policy = HR_DEFAULT_GROWTH_POLICY;                                            \
+        (_heap)->cap = (_cap);                                                                 \
+        (_heap)->size = 0;                                                                     \
+        (_heap)->used = 0;                                                                     \
+        (_heap)->cmp = (_cmp);                                                                 \
+        (_heap)->items = HR_ALLOC((_heap)->allocator, sizeof(*(_heap)->items) * (_heap)->cap); \
+        (_heap)->handles =                                                                     \
+            HR_ALLOC((_heap)->allocator, sizeof(*(_heap)->handles) * (_heap)->cap);            \
+        (_heap)->pos = HR_ALLOC((_heap)->allocator, sizeof(*(_heap)->pos) * (_heap)->cap);     \
+    })
+
+/**
+ * \brief     A macro for freeing an indexed heap.
+ * \note      This macro frees an indexed heap using the allocator specified
+ *            when initializing the heap.
+ * \param[in] _heap The heap to free.
+ */
+#define indexed_heap_free(_heap)                          \
+    ({                                                    \
+        HR_DEALLOC((_heap)->allocator, (_heap)->items);   \
+        HR_DEALLOC((_heap)->allocator, (_heap)->handles); \
+        HR_DEALLOC((_heap)->allocator, (_heap)->pos);     \
+    })
+
+// Getters
+
+/**
+ * \brief     A macro for getting the size of an indexed heap.
+ * \param[in] _heap The heap to get the size of.
+ */
+#define indexed_heap_get_size(_heap) ({ (_heap)->size; })
+
+/**
+ * \brief     A macro for getting the capacity of an indexed heap.
+ * \param[in] _heap The heap to get the capacity of.
+ */
+#define indexed_heap_get_cap(_heap) ({ (_heap)->cap; })
+
+/**
+ * \brief     A macro for getting the comparison function of an indexed heap.
+ * \param[in] _heap The heap to get the comparison function of.
+ */
+#define indexed_heap_get_cmp(_heap) ({ (_heap)->cmp; })
+
+// Setters
+
+/**
+ * \brief     A macro for setting the growth policy of an indexed heap.
+ * \note      This macro sets the policy deciding how an indexed heap grows.
+ *            The policy is not copied and must outlive the heap.
+ * \param[in] _heap The heap to set the growth policy of.
+ * \param[in] _policy The growth policy to set the heap to.
+ */
+#define indexed_heap_set_policy(_heap, _policy) ({ (_heap)->policy = (_policy); })
+
+/**
+ * \brief     A macro for checking if an indexed heap is empty.
+ * \param[in] _heap The heap to check.
+ */
+#define indexed_heap_empty(_heap) ({ (_heap)->size == 0; })
+
+/**
+ * \brief     A macro for checking if a handle is in an indexed heap.
+ * \note      A handle is in the heap from the push that returned it until
+ *            it is popped or removed.
+ * \param[in] _heap The heap to check.
+ * \param[in] _handle The handle to check for.
+ */
+#define indexed_heap_contains(_heap, _handle)                                   \
+    ({                                                                          \
+        const size_t _ct_handle = (_handle);                                    \
+        _ct_handle < (_heap)->used && (_heap)->pos[_ct_handle] < (_heap)->size; \
+    })
+
+/**
+ * \brief     A macro for pushing an item to an indexed heap.
+ * \note      This macro pushes an item to an indexed heap and moves it up
+ *            to its place. The handle of a popped or removed item may be
+ *            handed out again.
+ * \param[in] _heap The heap to push the item to.
+ * \param[in] _item The item to push to the heap.
+ * \return    The handle of the item.
+ */
+#define indexed_heap_push(_heap, _item)                                                      \
+    ({                                                                                       \
+        if ((_heap)->size == (_heap)->used) {                                                \
+            if ((_heap)->used == (_heap)->cap)                                               \
+                _indexed_heap_set_cap(_heap, _policy_grow_cap((_heap)->policy, (_heap)->cap, \
+                                                              (_heap)->used + 1));           \
+            (_heap)->handles[(_heap)->used] = (_heap)->used;                                 \
+            (_heap)->pos[(_heap)->used] = (_heap)->used;                                     \
+            (_heap)->used++;                                                                 \
+        }                                                                                    \
+        const size_t _ps_handle = (_heap)->handles[(_heap)->size++];                         \
+        (_heap)->items[_ps_handle] = *(_item);                                               \
+        _indexed_heap_sift_up(_heap, (_heap)->size - 1);                                     \
+        _ps_handle;                                                                          \
+    })
+
+/**
+ * \brief     A macro for getting the item of a handle in an indexed heap.
+ * \param[in] _heap The heap to get the item from.
+ * \param[in] _handle The handle of the item, which must be in the heap.
+ */
+#define indexed_heap_get(_heap, _handle) ({ (_heap)->items[(_handle)]; })
+
+/**
+ * \brief     A macro for getting the item at the front of an indexed heap.
+ * \note      This macro does not pop the item from the heap.
+ * \param[in] _heap The heap to get the item from.
+ */
+#define indexed_heap_peek(_heap) ({ (_heap)->items[(_heap)->handles[0]]; })
+
+/**
+ * \brief     A macro for getting the handle at the front of an indexed heap.
+ * \note      This macro does not pop the item from the heap.
+ * \param[in] _heap The heap to get the handle from.
+ */
+#define indexed_heap_peek_handle(_heap) ({ (_heap)->handles[0]; })
+
+/**
+ * \brief     A macro for popping an item from an indexed heap.
+ * \note      This macro pops the front item and frees its handle. Use
+ *            indexed_heap_peek_handle first to learn which handle it had.
+ * \param[in] _heap The heap to pop the item from.
+ */
+#define indexed_heap_pop(_heap)                        \
+    ({                                                 \
+        const size_t _pp_handle = (_heap)->handles[0]; \
+        _indexed_heap_unlink(_heap, _pp_handle);       \
+        (_heap)->items[_pp_handle];                    \
+    })
+
+/**
+ * \brief     A macro for removing an item from an indexed heap by handle.
+ * \note      This macro removes the item of the handle wherever it is in
+ *            the heap and frees the handle, in O(log n) time.
+ * \param[in] _heap The heap to remove the item from.
+ * \param[in] _handle The handle of the item, which must be in the heap.
+ */
+#define indexed_heap_remove(_heap, _handle)      \
+    ({                                           \
+        const size_t _rm_handle = (_handle);     \
+        _indexed_heap_unlink(_heap, _rm_handle); \
+        (_heap)->items[_rm_handle];              \
+    })
+
+/**
+ * \brief     A macro for moving an item of an indexed heap to the front.
+ * \note      This macro replaces the item of the handle with one that
+ *            compares lower or equal, such as a shorter distance in
+ *            Dijkstra's algorithm, and moves it up.
+ * \param[in] _heap The heap to update.
+ * \param[in] _handle The handle of the item, which must be in the heap.
+ * \param[in] _item The new item of the handle.
+ */
+#define indexed_heap_decrease_key(_heap, _handle, _item)        \
+    ({                                                          \
+        const size_t _dk_handle = (_handle);                    \
+        (_heap)->items[_dk_handle] = *(_item);                  \
+        _indexed_heap_sift_up(_heap, (_heap)->pos[_dk_handle]); \
+    })
+
+/**
+ * \brief     A macro for moving an item of an indexed heap to the back.
+ * \note      This macro replaces the item of the handle with one that
+ *            compares greater or equal and moves it down.
+ * \param[in] _heap The heap to update.
+ * \param[in] _handle The handle of the item, which must be in the heap.
+ * \param[in] _item The new item of the handle.
+ */
+#define indexed_heap_increase_key(_heap, _handle, _item)          \
+    ({                                                            \
+        const size_t _ik_handle = (_handle);                      \
+        (_heap)->items[_ik_handle] = *(_item);                    \
+        _indexed_heap_sift_down(_heap, (_heap)->pos[_ik_handle]); \
+    })
+
+/**
+ * \brief     A macro for updating an item of an indexed heap.
+ * \note      This macro replaces the item of the handle with any new item
+ *            and moves it up or down to its place.
+ * \param[in] _heap The heap to update.
+ * \param[in] _handle The handle of the item, which must be in the heap.
+ * \param[in] _item The new item of the handle.
+ */
+#define indexed_heap_update(_heap, _handle, _item)            \
+    ({                                                        \
+        const size_t _up_handle = (_handle);                  \
+        const size_t _up_idx = (_heap)->pos[_up_handle];      \
+        (_heap)->items[_up_handle] = *(_item);                \
+        if (_indexed_heap_sift_up(_heap, _up_idx) == _up_idx) \
+            _indexed_heap_sift_down(_heap, _up_idx);          \
+    })
+
+#endif // HURUST_INDEXED_HEAP_H
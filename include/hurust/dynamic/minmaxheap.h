@@ -0,0 +1,323 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/*==========================================================================*
+
+  FILE
+    minmaxheap.h
+
+  PROJECT
+    hurust generic library
+
+  DESCRIPTION
+    This file contains the min-max heap implementation, a double ended
+    priority queue in a single array where both the lowest and the highest
+    item can be peeked in O(1) and popped in O(log n) time.
+
+  PROGRAMMER
+    Callum Gran.
+
+  MODIFICATIONS
+    18-Oct-26  C.Gran		Created file.
+
+ *==========================================================================*/
+#ifndef HURUST_MINMAX_HEAP_H
+#define HURUST_MINMAX_HEAP_H
+
+#include "../alloc.h"
+#include "../common.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * \brief     A macro for defining a min-max heap.
+ * \note      This macro defines a min-max heap with the given type and
+ *            struct prefix. The levels of the tree alternate, every item on
+ *            an even level is the lowest of its subtree and every item on an
+ *            odd level the highest, so the lowest item is the root and the
+ *            highest is one of its children.
+ * \param[in] type The type of the heap.
+ * \param[in] struct_prefix The prefix for the heap struct.
+ * \note      The struct prefix parameter is used to define the heap struct
+ *            name as some types such as pointers and heaps cannot be used
+ *            as struct names.
+ */
+#define MINMAX_HEAP(type, struct_prefix)           \
+    typedef struct struct_prefix##_minmax_heap_t { \
+        type *data;                                \
+        size_t size;                               \
+        size_t cap;                                \
+        int (*cmp)(const type, const type);        \
+        struct hr_allocator_t *allocator;          \
+        const struct hr_growth_policy_t *policy;   \
+    } struct_prefix##_minmax_heap_t;
+
+/**
+ * \brief     Internal macro for checking if an index is on a min level.
+ * \param[in] _idx The index to check.
+ * \note      This macro is internal and should not be used.
+ */
+#define _minmax_heap_is_min_level(_idx) \
+    (((sizeof(unsigned long long) * 8 - 1 - __builtin_clzll((_idx) + 1)) & 1) == 0)
+
+/**
+ * \brief     Internal macro for checking if an item belongs above another.
+ * \note      On a min level an item belongs above a higher one, and on a max
+ *            level above a lower one.
+ * \param[in] _heap The heap to compare with.
+ * \param[in] _min Whether the comparison is for a min level.
+ * \param[in] _a The item to check.
+ * \param[in] _b The item to check against.
+ * \note      This macro is internal and should not be used.
+ */
+#define _minmax_heap_before(_heap, _min, _a, _b) \
+    ((_min) ? (_heap)->cmp((_a), (_b)) < 0 : (_heap)->cmp((_a), (_b)) > 0)
+
+/**
+ * \brief     Internal macro for moving an item of a min-max heap up.
+ * \note      This macro first moves the item to the parent if it belongs on
+ *            the other kind of level, and then moves the hole it leaves up
+ *            through the grandparents of that kind, writing the item once.
+ * \param[in] _heap The heap to heapify up.
+ * \param[in] _start The index of the item to move up.
+ * \note      This macro is internal and should not be used.
+ */
+#define _minmax_heap_sift_up(_heap, _start)                                                  \
+    ({                                                                                       \
+        size_t _su_idx = (_start);                                                           \
+        _typeofarray((_heap)->data) _su_item = (_heap)->data[_su_idx];                       \
+        bool _su_min = _minmax_heap_is_min_level(_su_idx);                                   \
+        if (_su_idx > 0) {                                                                   \
+            const size_t _su_parent = (_su_idx - 1) >> 1;                                    \
+            if (_minmax_heap_before(_heap, !_su_min, _su_item, (_heap)->data[_su_parent])) { \
+                (_heap)->data[_su_idx] = (_heap)->data[_su_parent];                          \
+                _su_idx = _su_parent;                                                        \
+                _su_min = !_su_min;                                                          \
+            }                                                                                \
+        }                                                                                    \
+        while (_su_idx >= 3) {                                                               \
+            const size_t _su_grand = (_su_idx - 3) >> 2;                                     \
+            if (!_minmax_heap_before(_heap, _su_min, _su_item, (_heap)->data[_su_grand]))    \
+                break;                                                                       \
+            (_heap)->data[_su_idx] = (_heap)->data[_su_grand];                               \
+            _su_idx = _su_grand;                                                             \
+        }                                                                                    \
+        (_heap)->data[_su_idx] = _su_item;                                                   \
+    })
+
+/**
+ * \brief     Internal macro for moving an item of a min-max heap down.
+ * \note      This macro moves the hole left by the item down to the child or
+ *            grandchild that belongs above it. When it moves to a grandchild
+ *            and the item belongs on the other kind of level, the item is
+ *            traded with the parent of that grandchild on the way.
+ * \param[in] _heap The heap to heapify down.
+ * \param[in] _start The index of the item to move down.
+ * \note      This macro is internal and should not be used.
+ */
+#define _minmax_heap_sift_down(_heap, _start)                                                     \
+    ({                                                                                            \
+        size_t _sd_idx = (_start);                                                                \
+        _typeofarray((_heap)->data) _sd_item = (_heap)->data[_sd_idx];                            \
+        const bool _sd_min = _minmax_heap_is_min_level(_sd_idx);                                  \
+        for (;;) {                                                                                \
+            const size_t _sd_child = (_sd_idx << 1) + 1;                                          \
+            if (_sd_child >= (_heap)->size)                                                       \
+                break;                                                                            \
+            const size_t _sd_grand = (_sd_idx << 2) + 3;                                          \
+            size_t _sd_best = _sd_child;                                                          \
+            if (_sd_child + 1 < (_heap)->size &&                                                  \
+                _minmax_heap_before(_heap, _sd_min, (_heap)->data[_sd_child + 1],                 \
+                                    (_heap)->data[_sd_best]))                                     \
+                _sd_best = _sd_child + 1;                                                         \
+            const size_t _sd_end = _sd_grand + 4 < (_heap)->size ? _sd_grand + 4 : (_heap)->size; \
+            for (size_t _sd_k = _sd_grand; _sd_k < _sd_end; _sd_k++)                              \
+                if (_minmax_heap_before(_heap, _sd_min, (_heap)->data[_sd_k],                     \
+                                        (_heap)->data[_sd_best]))                                 \
+                    _sd_best = _sd_k;                                                             \
+            if (!_minmax_heap_before(_heap, _sd_min, (_heap)->data[_sd_best], _sd_item))          \
+                break;                                                                            \
+            (_heap)->data[_sd_idx] = (_heap)->data[_sd_best];                                     \
+            _sd_idx = _sd_best;                                                                   \
+            if (_sd_best < _sd_grand)                                                             \
+                break;                                                                            \
+            const size_t _sd_parent = (_sd_best - 1) >> 1;                                        \
+            if (_minmax_heap_before(_heap, _sd_min, (_heap)->data[_sd_parent], _sd_item)) {       \
+                _typeofarray((_heap)->data) _sd_tmp = (_heap)->data[_sd_parent];                  \
+                (_heap)->data[_sd_parent] = _sd_item;                                             \
+                _sd_item = _sd_tmp;                                                               \
+            }                                                                                     \
+        }                                                                                         \
+        (_heap)->data[_sd_idx] = _sd_item;                                                        \
+    })
+
+/**
+ * \brief     Internal macro for getting the index of the highest item of a
+ *            min-max heap.
+ * \param[in] _heap The heap to get the index from, which must not be empty.
+ * \note      This macro is internal and should not be used.
+ */
+#define _minmax_heap_max_idx(_heap)                             \
+    ((_heap)->size == 1   ? 0                                   \
+     : (_heap)->size == 2 ? 1                                   \
+     : (_heap)->cmp((_heap)->data[2], (_heap)->data[1]) > 0 ? 2 \
+                                                              : 1)
+
+/**
+ * \brief     Internal macro for removing the item at an index of a min-max
+ *            heap.
+ * \note      This macro moves the last item into the index, moves it down
+ *            and shrinks the heap if the growth policy says so.
+ * \param[in] _heap The heap to remove the item from.
+ * \param[in] _idx The index of the item, the root or one of its children.
+ * \return    The removed item.
+ * \note      This macro is internal and should not be used.
+ */
+#define _minmax_heap_take(_heap, _idx)                             \
+    ({                                                             \
+        const size_t _tk_idx = (_idx);                             \
+        _typeofarray((_heap)->data) _ret = (_heap)->data[_tk_idx]; \
+        if (_tk_idx < --(_heap)->size) {                           \
+            (_heap)->data[_tk_idx] = (_heap)->data[(_heap)->size]; \
+            _minmax_heap_sift_down(_heap, _tk_idx);                \
+        }                                                          \
+        _reduce_cap(_heap);                                        \
+        _ret;                                                      \
+    })
+
+/**
+ * \brief     A macro for initializing a min-max heap.
+ * \note      This macro initializes a min-max heap with the given allocator,
+ *            capacity and comparison function for arranging the heap.
+ * \param[in] _heap The heap to initialize.
+ * \param[in] _allocator The allocator to use for the heap.
+ * \param[in] _cap The starting capacity of the heap.
+ * \param[in] _cmp The comparison function for arranging the heap.
+ */
+#define minmax_heap_init(_heap, _allocator, _cap, _cmp)                                      \
+    ({                                                                                       \
+        (_heap)->allocator = (_allocator);                                                   \
+        (_heap)->policy = HR_DEFAULT_GROWTH_POLICY;                                          \
+        (_heap)->cap = (_cap);                                                               \
+        (_heap)->size = 0;                                                                   \
+        (_heap)->cmp = (_cmp);                                                               \
+        (_heap)->data = HR_ALLOC((_heap)->allocator, sizeof(*(_heap)->data) * (_heap)->cap); \
+    })
+
+/**
+ * \brief     A macro for freeing a min-max heap.
+ * \note      This macro frees a min-max heap using the allocator specified
+ *            when initializing the heap.
+ * \param[in] _heap The heap to free.
+ */
+#define minmax_heap_free(_heap) ({ HR_DEALLOC((_heap)->allocator, (_heap)->data); })
+
+// Getters
+
+/**
+ * \brief     A macro for getting the size of a min-max heap.
+ * \param[in] _heap The heap to get the size of.
+ */
+#define minmax_heap_get_size(_heap) ({ (_heap)->size; })
+
+/**
+ * \brief     A macro for getting the capacity of a min-max heap.
+ * \param[in] _heap The heap to get the capacity of.
+ */
+#define minmax_heap_get_cap(_heap) ({ (_heap)->cap; })
+
+/**
+ * \brief     A macro for getting the comparison function of a min-max heap.
+ * \param[in] _heap The heap to get the comparison function of.
+ */
+#define minmax_heap_get_cmp(_heap) ({ (_heap)->cmp; })
+
+// Setters
+
+/**
+ * \brief     A macro for setting the growth policy of a min-max heap.
+ * \note      This macro sets the policy deciding how a min-max heap grows and
+ *            shrinks. The policy is not copied and must outlive the heap.
+ * \param[in] _heap The heap to set the growth policy of.
+ * \param[in] _policy The growth policy to set the heap to.
+ */
+#define minmax_heap_set_policy(_heap, _policy) ({ (_heap)->policy = (_policy); })
+
+/**
+ * \brief     A macro for checking if a min-max heap is empty.
+ * \param[in] _heap The heap to check.
+ */
+#define minmax_heap_empty(_heap) ({ (_heap)->size == 0; })
+
+/**
+ * \brief     A macro for pushing an item to a min-max heap.
+ * \param[in] _heap The heap to push the item to.
+ * \param[in] _item The item to push to the heap.
+ */
+#define minmax_heap_push(_heap, _item)                  \
+    ({                                                  \
+        _ensure_cap(_heap);                             \
+        (_heap)->data[(_heap)->size++] = *(_item);      \
+        _minmax_heap_sift_up(_heap, (_heap)->size - 1); \
+    })
+
+/**
+ * \brief     A macro for building a min-max heap from an array.
+ * \note      This macro replaces the items of a min-max heap with a copy of
+ *            the given array and arranges them in O(n) time.
+ * \param[in] _heap The heap to build.
+ * \param[in] _arr The array of items to copy into the heap.
+ * \param[in] _n The number of items in the array.
+ */
+#define minmax_heap_from_array(_heap, _arr, _n)                        \
+    ({                                                                 \
+        const size_t _fa_n = (_n);                                     \
+        (_heap)->size = 0;                                             \
+        _reserve_cap(_heap, _fa_n);                                    \
+        memcpy((_heap)->data, (_arr), sizeof(*(_heap)->data) * _fa_n); \
+        (_heap)->size = _fa_n;                                         \
+        for (size_t _fa_i = _fa_n / 2; _fa_i > 0; _fa_i--)             \
+            _minmax_heap_sift_down(_heap, _fa_i - 1);                  \
+    })
+
+/**
+ * \brief     A macro for getting the lowest item of a min-max heap.
+ * \note      This macro does not pop the item from the heap.
+ * \param[in] _heap The heap to get the item from.
+ */
+#define minmax_heap_peek_min(_heap) ({ (_heap)->data[0]; })
+
+/**
+ * \brief     A macro for getting the highest item of a min-max heap.
+ * \note      This macro does not pop the item from the heap.
+ * \param[in] _heap The heap to get the item from.
+ */
+#define minmax_heap_peek_max(_heap) ({ (_heap)->data[_minmax_heap_max_idx(_heap)]; })
+
+/**
+ * \brief     A macro for popping the lowest item of a min-max heap.
+ * \param[in] _heap The heap to pop the item from.
+ */
+#define minmax_heap_pop_min(_heap) ({ _minmax_heap_take(_heap, 0); })
+
+/**
+ * \brief     A macro for popping the highest item of a min-max heap.
+ * \param[in] _heap The heap to pop the item from.
+ */
+#define minmax_heap_pop_max(_heap) ({ _minmax_heap_take(_heap, _minmax_heap_max_idx(_heap)); })
+
+#endif // HURUST_MINMAX_HEAP_H
@@ -0,0 +1,263 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/*==========================================================================*
+
+  FILE
+    multiqueue.h
+
+  PROJECT
+    hurust generic library
+
+  DESCRIPTION
+    This file contains the MultiQueue implementation, a thread safe relaxed
+    priority queue made of several heaps that each sit behind their own lock.
+    Pushes go to a random heap and pops take the better front item of two
+    random heaps, so threads rarely wait on the same lock and the popped
+    item is close to, but not always, the front item of the whole queue.
+
+  PROGRAMMER
+    Callum Gran.
+
+  MODIFICATIONS
+    18-Oct-26  C.Gran		Created file.
+
+ *==========================================================================*/
+#ifndef HURUST_MULTIQUEUE_H
+#define HURUST_MULTIQUEUE_H
+
+#include "../alloc.h"
+#include "../common.h"
+#include "heap.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \brief     The alignment of the shards of a MultiQueue, so that two locks
+ *            never share a cache line.
+ */
+#define HR_MULTIQUEUE_ALIGN 64
+
+/**
+ * \brief     The starting capacity of the heap of every shard of a MultiQueue.
+ */
+#define HR_MULTIQUEUE_SHARD_CAP 16
+
+/**
+ * \brief     The number of random shards a push or pop tries to lock without
+ *            waiting before it waits on the lock of the last one it picked.
+ * \note      With around two shards per thread most locks are free, so a few
+ *            tries almost always find one. The bound stops a thread from
+ *            spinning when every shard is busy.
+ */
+#define HR_MULTIQUEUE_TRYLOCK_RETRIES 4
+
+/**
+ * \brief     Internal function for getting a random number for picking shards.
+ * \note      Every thread has its own xorshift state, seeded from the address
+ *            of the state, so no thread waits on another to get a number.
+ * \return    A random number.
+ * \note      This function is internal and should not be used.
+ */
+static inline uint64_t _multiqueue_rand(void)
+{
+    static _Thread_local uint64_t state = 0;
+    if (state == 0)
+        state = ((uint64_t)(uintptr_t)&state * 0x9E3779B97F4A7C15ULL) | 1;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+/**
+ * \brief     A macro for defining a MultiQueue.
+ * \note      This macro defines a MultiQueue with the given type and struct
+ *            prefix, along with the heap and shard structs it is made of.
+ *            The size is kept on its own cache line as every push and pop
+ *            changes it.
+ * \param[in] type The type of the MultiQueue.
+ * \param[in] struct_prefix The prefix for the MultiQueue struct.
+ * \note      The struct prefix parameter is used to define the MultiQueue
+ *            struct name as some types such as pointers and heaps cannot be
+ *            used as struct names.
+ */
+#define MULTIQUEUE(type, struct_prefix)                    \
+    HEAP(type, struct_prefix##_mq)                         \
+    typedef struct struct_prefix##_multiqueue_shard_t {    \
+        pthread_mutex_t lock;                              \
+        struct struct_prefix##_mq_heap_t heap;             \
+    } __attribute__((aligned(HR_MULTIQUEUE_ALIGN)))        \
+    struct_prefix##_multiqueue_shard_t;                    \
+    typedef struct struct_prefix##_multiqueue_t {          \
+        struct struct_prefix##_multiqueue_shard_t *shards; \
+        void *raw;                                         \
+        size_t nshards;                                    \
+        struct hr_allocator_t *allocator;                  \
+        _Alignas(HR_MULTIQUEUE_ALIGN) atomic_size_t size;  \
+    } struct_prefix##_multiqueue_t;
+
+/**
+ * \brief     A macro for initializing a MultiQueue.
+ * \note      This macro initializes a MultiQueue with the given number of
+ *            shards, each a heap with its own lock. Around two shards per
+ *            thread keeps the locks mostly free. The shards allocate from
+ *            more than one thread, so the allocator must be thread safe.
+ * \param[in] _mq The MultiQueue to initialize.
+ * \param[in] _allocator The allocator to use for the MultiQueue.
+ * \param[in] _nshards The number of shards, which must be at least one.
+ * \param[in] _cmp The comparison function for arranging the heaps.
+ */
+#define multiqueue_init(_mq, _allocator, _nshards, _cmp)                                      \
+    ({                                                                                        \
+        (_mq)->allocator = (_allocator);                                                      \
+        (_mq)->nshards = (_nshards);                                                          \
+        (_mq)->raw = HR_ALLOC((_mq)->allocator,                                               \
+                              sizeof(*(_mq)->shards) * (_mq)->nshards + HR_MULTIQUEUE_ALIGN); \
+        uintptr_t _mi_base = ((uintptr_t)(_mq)->raw + HR_MULTIQUEUE_ALIGN - 1) &              \
+                             ~(uintptr_t)(HR_MULTIQUEUE_ALIGN - 1);                           \
+        (_mq)->shards = (typeof((_mq)->shards))_mi_base;                                      \
+        for (size_t _mi_i = 0; _mi_i < (_mq)->nshards; _mi_i++) {                             \
+            pthread_mutex_init(&(_mq)->shards[_mi_i].lock, NULL);                             \
+            heap_init(&(_mq)->shards[_mi_i].heap, (_mq)->allocator, HR_MULTIQUEUE_SHARD_CAP,  \
+                      (_cmp));                                                                \
+        }                                                                                     \
+        atomic_init(&(_mq)->size, 0);                                                         \
+    })
+
+/**
+ * \brief     A macro for freeing a MultiQueue.
+ * \note      This macro frees the heaps and locks of a MultiQueue. No other
+ *            thread may use the MultiQueue while it is freed.
+ * \param[in] _mq The MultiQueue to free.
+ */
+#define multiqueue_free(_mq)                                      \
+    ({                                                            \
+        for (size_t _mf_i = 0; _mf_i < (_mq)->nshards; _mf_i++) { \
+            heap_free(&(_mq)->shards[_mf_i].heap);                \
+            pthread_mutex_destroy(&(_mq)->shards[_mf_i].lock);    \
+        }                                                         \
+        HR_DEALLOC((_mq)->allocator, (_mq)->raw);                 \
+    })
+
+// Getters
+
+/**
+ * \brief     A macro for getting the size of a MultiQueue.
+ * \note      Other threads may change the size right after it is read.
+ * \param[in] _mq The MultiQueue to get the size of.
+ */
+#define multiqueue_get_size(_mq) ({ atomic_load(&(_mq)->size); })
+
+/**
+ * \brief     A macro for getting the number of shards of a MultiQueue.
+ * \param[in] _mq The MultiQueue to get the number of shards of.
+ */
+#define multiqueue_get_nshards(_mq) ({ (_mq)->nshards; })
+
+/**
+ * \brief     A macro for checking if a MultiQueue is empty.
+ * \note      Other threads may push or pop right after it is checked.
+ * \param[in] _mq The MultiQueue to check.
+ */
+#define multiqueue_empty(_mq) ({ multiqueue_get_size(_mq) == 0; })
+
+/**
+ * \brief     A macro for pushing an item to a MultiQueue.
+ * \note      This macro pushes the item to a random shard, trying other
+ *            random shards while the lock of the picked one is taken. After
+ *            HR_MULTIQUEUE_TRYLOCK_RETRIES taken locks it waits on the last
+ *            one. The size is raised once the item is in its heap, so a pop
+ *            that sees the item counted can always find it.
+ * \param[in] _mq The MultiQueue to push the item to.
+ * \param[in] _item The item to push to the MultiQueue.
+ */
+#define multiqueue_push(_mq, _item)                                          \
+    ({                                                                       \
+        typeof((_mq)->shards) _mu_shard;                                     \
+        size_t _mu_tries = 0;                                                \
+        do {                                                                 \
+            _mu_shard = &(_mq)->shards[_multiqueue_rand() % (_mq)->nshards]; \
+        } while (pthread_mutex_trylock(&_mu_shard->lock) != 0 &&             \
+                 ++_mu_tries < HR_MULTIQUEUE_TRYLOCK_RETRIES);               \
+        if (_mu_tries == HR_MULTIQUEUE_TRYLOCK_RETRIES)                      \
+            pthread_mutex_lock(&_mu_shard->lock);                            \
+        heap_push(&_mu_shard->heap, (_item));                                \
+        pthread_mutex_unlock(&_mu_shard->lock);                              \
+        atomic_fetch_add_explicit(&(_mq)->size, 1, memory_order_release);    \
+    })
+
+/**
+ * \brief     A macro for popping an item from a MultiQueue.
+ * \note      This macro first claims one of the counted items by lowering
+ *            the size, then locks two random shards and pops the better of
+ *            their front items. Shards that are taken or empty are skipped
+ *            for new random ones, but after HR_MULTIQUEUE_TRYLOCK_RETRIES
+ *            taken first shards in a row it waits on the last one. The
+ *            second shard is only ever tried, so a thread never waits while
+ *            holding a lock. The popped item is not always the front
+ *            item of the whole MultiQueue, but its rank is on average within
+ *            a small multiple of the number of shards.
+ * \param[in] _mq The MultiQueue to pop the item from.
+ * \param[out] _out Where to store the popped item.
+ * \return    True if an item was popped, false if the MultiQueue was empty.
+ */
+#define multiqueue_pop(_mq, _out)                                                            \
+    ({                                                                                       \
+        bool _mp_ok = false;                                                                 \
+        size_t _mp_size = atomic_load_explicit(&(_mq)->size, memory_order_relaxed);          \
+        while (_mp_size > 0) {                                                               \
+            if (atomic_compare_exchange_weak_explicit(&(_mq)->size, &_mp_size, _mp_size - 1, \
+                                                      memory_order_acquire,                  \
+                                                      memory_order_relaxed)) {               \
+                _mp_ok = true;                                                               \
+                break;                                                                       \
+            }                                                                                \
+        }                                                                                    \
+        size_t _mp_tries = 0;                                                                \
+        while (_mp_ok) {                                                                     \
+            size_t _mp_a = _multiqueue_rand() % (_mq)->nshards;                              \
+            if (pthread_mutex_trylock(&(_mq)->shards[_mp_a].lock) != 0) {                    \
+                if (++_mp_tries < HR_MULTIQUEUE_TRYLOCK_RETRIES)                             \
+                    continue;                                                                \
+                pthread_mutex_lock(&(_mq)->shards[_mp_a].lock);                              \
+            }                                                                                \
+            _mp_tries = 0;                                                                   \
+            size_t _mp_b = _multiqueue_rand() % (_mq)->nshards;                              \
+            bool _mp_pair = _mp_b != _mp_a &&                                                \
+                            pthread_mutex_trylock(&(_mq)->shards[_mp_b].lock) == 0;          \
+            typeof((_mq)->shards) _mp_best = NULL;                                           \
+            if (!heap_empty(&(_mq)->shards[_mp_a].heap))                                     \
+                _mp_best = &(_mq)->shards[_mp_a];                                            \
+            if (_mp_pair && !heap_empty(&(_mq)->shards[_mp_b].heap) &&                       \
+                (_mp_best == NULL ||                                                         \
+                 _mp_best->heap.cmp(heap_peek(&(_mq)->shards[_mp_b].heap),                   \
+                                    heap_peek(&_mp_best->heap)) < 0))                        \
+                _mp_best = &(_mq)->shards[_mp_b];                                            \
+            if (_mp_best != NULL)                                                            \
+                *(_out) = heap_pop(&_mp_best->heap);                                         \
+            if (_mp_pair)                                                                    \
+                pthread_mutex_unlock(&(_mq)->shards[_mp_b].lock);                            \
+            pthread_mutex_unlock(&(_mq)->shards[_mp_a].lock);                                \
+            if (_mp_best != NULL)                                                            \
+                break;                                                                       \
+        }                                                                                    \
+        _mp_ok;                                                                              \
+    })
+
+#endif // HURUST_MULTIQUEUE_H
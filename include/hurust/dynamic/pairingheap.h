@@ -0,0 +1,295 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/*==========================================================================*
+
+  FILE
+    pairingheap.h
+
+  PROJECT
+    hurust generic library
+
+  DESCRIPTION
+    This file contains the pairing heap implementation, a node based heap
+    where two heaps are melded in O(1) time and an item can be moved to the
+    front through the node handle returned when it was pushed.
+
+  PROGRAMMER
+    Callum Gran.
+
+  MODIFICATIONS
+    18-Oct-26  C.Gran		Created file.
+
+ *==========================================================================*/
+#ifndef HURUST_PAIRING_HEAP_H
+#define HURUST_PAIRING_HEAP_H
+
+#include "../alloc.h"
+#include "../common.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \brief     A macro for defining a pairing heap.
+ * \note      This macro defines a pairing heap with the given type and struct
+ *            prefix, along with its node struct. Every node points to its
+ *            first child and its next sibling, and back to its previous
+ *            sibling, or to its parent if it is the first child.
+ * \param[in] type The type of the heap.
+ * \param[in] struct_prefix The prefix for the heap struct.
+ * \note      The struct prefix parameter is used to define the heap struct
+ *            name as some types such as pointers and heaps cannot be used
+ *            as struct names.
+ */
+#define PAIRING_HEAP(type, struct_prefix)                  \
+    typedef struct struct_prefix##_pairing_heap_node_t {   \
+        type item;                                         \
+        struct struct_prefix##_pairing_heap_node_t *child; \
+        struct struct_prefix##_pairing_heap_node_t *next;  \
+        struct struct_prefix##_pairing_heap_node_t *prev;  \
+    } struct_prefix##_pairing_heap_node_t;                 \
+    typedef struct struct_prefix##_pairing_heap_t {        \
+        struct struct_prefix##_pairing_heap_node_t *root;  \
+        size_t size;                                       \
+        int (*cmp)(const type, const type);                \
+        struct hr_allocator_t *allocator;                  \
+    } struct_prefix##_pairing_heap_t;
+
+/**
+ * \brief     Internal macro for linking two pairing heap trees.
+ * \note      This macro makes the root that should be below the other one
+ *            the first child of it.
+ * \param[in] _heap The heap the trees belong to.
+ * \param[in] _a The root of the first tree.
+ * \param[in] _b The root of the second tree.
+ * \return    The root of the linked tree.
+ * \note      This macro is internal and should not be used.
+ */
+#define _pairing_heap_link(_heap, _a, _b)                     \
+    ({                                                        \
+        typeof((_heap)->root) _lk_top = (_a);                 \
+        typeof((_heap)->root) _lk_sub = (_b);                 \
+        if ((_heap)->cmp(_lk_sub->item, _lk_top->item) < 0) { \
+            typeof((_heap)->root) _lk_tmp = _lk_top;          \
+            _lk_top = _lk_sub;                                \
+            _lk_sub = _lk_tmp;                                \
+        }                                                     \
+        _lk_sub->prev = _lk_top;                              \
+        _lk_sub->next = _lk_top->child;                       \
+        if (_lk_top->child != NULL)                           \
+            _lk_top->child->prev = _lk_sub;                   \
+        _lk_top->child = _lk_sub;                             \
+        _lk_top->prev = NULL;                                 \
+        _lk_top->next = NULL;                                 \
+        _lk_top;                                              \
+    })
+
+/**
+ * \brief     Internal macro for linking a tree with the root of a pairing
+ *            heap.
+ * \param[in] _heap The heap to link the tree into.
+ * \param[in] _node The root of the tree.
+ * \note      This macro is internal and should not be used.
+ */
+#define _pairing_heap_insert(_heap, _node)                                        \
+    ({                                                                            \
+        typeof((_heap)->root) _is_node = (_node);                                 \
+        (_heap)->root = (_heap)->root == NULL                                     \
+                            ? _is_node                                            \
+                            : _pairing_heap_link(_heap, (_heap)->root, _is_node); \
+    })
+
+/**
+ * \brief     A macro for initializing a pairing heap.
+ * \note      This macro initializes an empty pairing heap. Every node is
+ *            allocated on its own with the given allocator, so a pool
+ *            allocator of node sized blocks suits it well.
+ * \param[in] _heap The heap to initialize.
+ * \param[in] _allocator The allocator to use for the nodes of the heap.
+ * \param[in] _cmp The comparison function for arranging the heap.
+ */
+#define pairing_heap_init(_heap, _allocator, _cmp) \
+    ({                                             \
+        (_heap)->allocator = (_allocator);         \
+        (_heap)->root = NULL;                      \
+        (_heap)->size = 0;                         \
+        (_heap)->cmp = (_cmp);                     \
+    })
+
+/**
+ * \brief     A macro for freeing a pairing heap.
+ * \note      This macro frees every node of a pairing heap in O(n) time
+ *            without extra memory, by walking down through the first
+ *            children and keeping the way back in the next pointers.
+ * \param[in] _heap The heap to free.
+ */
+#define pairing_heap_free(_heap)                                  \
+    ({                                                            \
+        typeof((_heap)->root) _fr_cur = (_heap)->root;            \
+        while (_fr_cur != NULL) {                                 \
+            if (_fr_cur->child != NULL) {                         \
+                typeof((_heap)->root) _fr_child = _fr_cur->child; \
+                _fr_cur->child = _fr_child->next;                 \
+                _fr_child->next = _fr_cur;                        \
+                _fr_cur = _fr_child;                              \
+            } else {                                              \
+                typeof((_heap)->root) _fr_up = _fr_cur->next;     \
+                HR_DEALLOC((_heap)->allocator, _fr_cur);          \
+                _fr_cur = _fr_up;                                 \
+            }                                                     \
+        }                                                         \
+        (_heap)->root = NULL;                                     \
+        (_heap)->size = 0;                                        \
+    })
+
+// Getters
+
+/**
+ * \brief     A macro for getting the size of a pairing heap.
+ * \param[in] _heap The heap to get the size of.
+ */
+#define pairing_heap_get_size(_heap) ({ (_heap)->size; })
+
+/**
+ * \brief     A macro for getting the comparison function of a pairing heap.
+ * \param[in] _heap The heap to get the comparison function of.
+ */
+#define pairing_heap_get_cmp(_heap) ({ (_heap)->cmp; })
+
+/**
+ * \brief     A macro for getting the item of a pairing heap node.
+ * \param[in] _node The node to get the item of.
+ */
+#define pairing_heap_get(_node) ({ (_node)->item; })
+
+/**
+ * \brief     A macro for checking if a pairing heap is empty.
+ * \param[in] _heap The heap to check.
+ */
+#define pairing_heap_empty(_heap) ({ (_heap)->size == 0; })
+
+/**
+ * \brief     A macro for pushing an item to a pairing heap.
+ * \note      This macro allocates a node for the item and links it with the
+ *            root in O(1) time.
+ * \param[in] _heap The heap to push the item to.
+ * \param[in] _item The item to push to the heap.
+ * \return    The node of the item, which stays valid until it is popped.
+ */
+#define pairing_heap_push(_heap, _item)                                                   \
+    ({                                                                                    \
+        typeof((_heap)->root) _ps_node = HR_ALLOC((_heap)->allocator, sizeof(*_ps_node)); \
+        _ps_node->item = *(_item);                                                        \
+        _ps_node->child = NULL;                                                           \
+        _ps_node->next = NULL;                                                            \
+        _ps_node->prev = NULL;                                                            \
+        _pairing_heap_insert(_heap, _ps_node);                                            \
+        (_heap)->size++;                                                                  \
+        _ps_node;                                                                         \
+    })
+
+/**
+ * \brief     A macro for getting the item at the front of a pairing heap.
+ * \note      This macro does not pop the item from the heap.
+ * \param[in] _heap The heap to get the item from.
+ */
+#define pairing_heap_peek(_heap) ({ (_heap)->root->item; })
+
+/**
+ * \brief     A macro for popping an item from a pairing heap.
+ * \note      This macro frees the root and links its children in two passes,
+ *            first in pairs from left to right and then the pairs from
+ *            right to left, in amortised O(log n) time.
+ * \param[in] _heap The heap to pop the item from.
+ */
+#define pairing_heap_pop(_heap)                                  \
+    ({                                                           \
+        typeof((_heap)->root) _pp_root = (_heap)->root;          \
+        typeof(_pp_root->item) _ret = _pp_root->item;            \
+        typeof((_heap)->root) _pp_list = _pp_root->child;        \
+        typeof((_heap)->root) _pp_pairs = NULL;                  \
+        while (_pp_list != NULL) {                               \
+            typeof((_heap)->root) _pp_a = _pp_list;              \
+            typeof((_heap)->root) _pp_b = _pp_a->next;           \
+            if (_pp_b == NULL) {                                 \
+                _pp_list = NULL;                                 \
+            } else {                                             \
+                _pp_list = _pp_b->next;                          \
+                _pp_a = _pairing_heap_link(_heap, _pp_a, _pp_b); \
+            }                                                    \
+            _pp_a->next = _pp_pairs;                             \
+            _pp_pairs = _pp_a;                                   \
+        }                                                        \
+        (_heap)->root = NULL;                                    \
+        while (_pp_pairs != NULL) {                              \
+            typeof((_heap)->root) _pp_next = _pp_pairs->next;    \
+            _pairing_heap_insert(_heap, _pp_pairs);              \
+            _pp_pairs = _pp_next;                                \
+        }                                                        \
+        if ((_heap)->root != NULL) {                             \
+            (_heap)->root->prev = NULL;                          \
+            (_heap)->root->next = NULL;                          \
+        }                                                        \
+        HR_DEALLOC((_heap)->allocator, _pp_root);                \
+        (_heap)->size--;                                         \
+        _ret;                                                    \
+    })
+
+/**
+ * \brief     A macro for moving an item of a pairing heap to the front.
+ * \note      This macro replaces the item of the node with one that compares
+ *            lower or equal, cuts the node with its subtree out of its
+ *            parent and links it with the root, in amortised O(log n) time.
+ * \param[in] _heap The heap the node belongs to.
+ * \param[in] _node The node of the item.
+ * \param[in] _item The new item of the node.
+ */
+#define pairing_heap_decrease_key(_heap, _node, _item)  \
+    ({                                                  \
+        typeof((_heap)->root) _dk_node = (_node);       \
+        _dk_node->item = *(_item);                      \
+        if (_dk_node != (_heap)->root) {                \
+            if (_dk_node->prev->child == _dk_node)      \
+                _dk_node->prev->child = _dk_node->next; \
+            else                                        \
+                _dk_node->prev->next = _dk_node->next;  \
+            if (_dk_node->next != NULL)                 \
+                _dk_node->next->prev = _dk_node->prev;  \
+            _dk_node->next = NULL;                      \
+            _dk_node->prev = NULL;                      \
+            _pairing_heap_insert(_heap, _dk_node);      \
+        }                                               \
+    })
+
+/**
+ * \brief     A macro for melding two pairing heaps.
+ * \note      This macro moves every item of the other heap into the heap in
+ *            O(1) time by linking the two roots, and leaves the other heap
+ *            empty. The nodes keep their addresses, so both heaps must use
+ *            the same allocator and comparison function.
+ * \param[in] _heap The heap to meld into.
+ * \param[in] _other The heap to meld from.
+ */
+#define pairing_heap_meld(_heap, _other)                 \
+    ({                                                   \
+        if ((_other)->root != NULL)                      \
+            _pairing_heap_insert(_heap, (_other)->root); \
+        (_heap)->size += (_other)->size;                 \
+        (_other)->root = NULL;                           \
+        (_other)->size = 0;                              \
+    })
+
+#endif // HURUST_PAIRING_HEAP_H
@@ -0,0 +1,257 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/*==========================================================================*
+
+  FILE
+    radixheap.h
+
+  PROJECT
+    hurust generic library
+
+  DESCRIPTION
+    This file contains the radix heap implementation, a monotone priority
+    queue for unsigned 64 bit keys that buckets items by the highest bit
+    where their key differs from the last popped key, without comparison
+    functions.
+
+  PROGRAMMER
+    Callum Gran.
+
+  MODIFICATIONS
+    18-Oct-26  C.Gran		Created file.
+
+ *==========================================================================*/
+#ifndef HURUST_RADIX_HEAP_H
+#define HURUST_RADIX_HEAP_H
+
+#include "../alloc.h"
+#include "../common.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \brief     The number of buckets of a radix heap, one for keys equal to the
+ *            last popped key and one for every bit of a key.
+ */
+#define HR_RADIX_HEAP_BUCKETS 65
+
+/**
+ * \brief     A macro for defining a radix heap.
+ * \note      This macro defines a radix heap with the given value type and
+ *            struct prefix, along with the entry struct holding a key and a
+ *            value. Bucket 0 holds the entries whose key is the last popped
+ *            key and bucket i holds the ones whose key first differs from it
+ *            at bit i - 1, counted from the least significant bit. A bit mask
+ *            tracks which of buckets 1 to 64 are not empty.
+ * \param[in] type The type of the values of the radix heap.
+ * \param[in] struct_prefix The prefix for the radix heap struct.
+ * \note      The struct prefix parameter is used to define the radix heap
+ *            struct name as some types such as pointers and heaps cannot be
+ *            used as struct names.
+ */
+#define RADIX_HEAP(type, struct_prefix)                      \
+    typedef struct struct_prefix##_radix_heap_entry_t {      \
+        uint64_t key;                                        \
+        type value;                                          \
+    } struct_prefix##_radix_heap_entry_t;                    \
+    typedef struct struct_prefix##_radix_heap_t {            \
+        struct {                                             \
+            struct struct_prefix##_radix_heap_entry_t *data; \
+            size_t size;                                     \
+            size_t cap;                                      \
+        } buckets[HR_RADIX_HEAP_BUCKETS];                    \
+        uint64_t mask;                                       \
+        uint64_t last;                                       \
+        size_t size;                                         \
+        struct hr_allocator_t *allocator;                    \
+        const struct hr_growth_policy_t *policy;             \
+    } struct_prefix##_radix_heap_t;
+
+/**
+ * \brief     Internal macro for getting the bucket of a key.
+ * \param[in] _last The last popped key.
+ * \param[in] _key The key to get the bucket of, not lower than the last key.
+ * \note      This macro is internal and should not be used.
+ */
+#define _radix_heap_bucket(_last, _key) \
+    ((_key) == (_last) ? 0 : (size_t)(64 - __builtin_clzll((_key) ^ (_last))))
+
+/**
+ * \brief     Internal macro for adding an entry to its bucket.
+ * \param[in] _heap The heap to add the entry to.
+ * \param[in] _entry The entry to add.
+ * \note      This macro is internal and should not be used.
+ */
+#define _radix_heap_insert(_heap, _entry)                                                         \
+    ({                                                                                            \
+        const typeof(*(_heap)->buckets[0].data) _in_entry = (_entry);                             \
+        const size_t _in_b = _radix_heap_bucket((_heap)->last, _in_entry.key);                    \
+        typeof(&(_heap)->buckets[0]) _in_bucket = &(_heap)->buckets[_in_b];                       \
+        if (_in_bucket->size == _in_bucket->cap) {                                                \
+            _in_bucket->cap =                                                                     \
+                _policy_grow_cap((_heap)->policy, _in_bucket->cap, _in_bucket->size + 1);         \
+            const size_t _in_bytes = sizeof(*_in_bucket->data) * _in_bucket->cap;                 \
+            _in_bucket->data = _in_bucket->data == NULL                                           \
+                                   ? HR_ALLOC((_heap)->allocator, _in_bytes)                      \
+                                   : HR_REALLOC((_heap)->allocator, _in_bucket->data, _in_bytes); \
+        }                                                                                         \
+        _in_bucket->data[_in_bucket->size++] = _in_entry;                                         \
+        if (_in_b > 0)                                                                            \
+            (_heap)->mask |= 1ULL << (_in_b - 1);                                                 \
+    })
+
+/**
+ * \brief     Internal macro for making sure bucket 0 of a radix heap holds
+ *            the entries with the lowest key.
+ * \note      If bucket 0 is empty, this macro finds the lowest non empty
+ *            bucket, makes its lowest key the last key and spreads its
+ *            entries over the lower buckets. Every entry only ever moves to
+ *            lower buckets, which bounds the work per entry by the number of
+ *            bits of a key.
+ * \param[in] _heap The heap to refill, which must not be empty.
+ * \note      This macro is internal and should not be used.
+ */
+#define _radix_heap_refill(_heap)                                               \
+    ({                                                                          \
+        if ((_heap)->buckets[0].size == 0) {                                    \
+            const size_t _rf_b = (size_t)__builtin_ctzll((_heap)->mask) + 1;    \
+            typeof(&(_heap)->buckets[0]) _rf_bucket = &(_heap)->buckets[_rf_b]; \
+            uint64_t _rf_min = _rf_bucket->data[0].key;                         \
+            for (size_t _rf_i = 1; _rf_i < _rf_bucket->size; _rf_i++)           \
+                if (_rf_bucket->data[_rf_i].key < _rf_min)                      \
+                    _rf_min = _rf_bucket->data[_rf_i].key;                      \
+            (_heap)->last = _rf_min;                                            \
+            (_heap)->mask &= ~(1ULL << (_rf_b - 1));                            \
+            for (size_t _rf_i = 0; _rf_i < _rf_bucket->size; _rf_i++)           \
+                _radix_heap_insert(_heap, _rf_bucket->data[_rf_i]);             \
+            _rf_bucket->size = 0;                                               \
+        }                                                                       \
+    })
+
+/**
+ * \brief     A macro for initializing a radix heap.
+ * \note      This macro initializes an empty radix heap with the given
+ *            allocator. The buckets are allocated when first used.
+ * \param[in] _heap The heap to initialize.
+ * \param[in] _allocator The allocator to use for the heap.
+ */
+#define radix_heap_init(_heap, _allocator)                               \
+    ({                                                                   \
+        (_heap)->allocator = (_allocator);                               \
+        (_heap)->policy = HR_DEFAULT_GROWTH_POLICY;                      \
+        for (size_t _ri_b = 0; _ri_b < HR_RADIX_HEAP_BUCKETS; _ri_b++) { \
+            (_heap)->buckets[_ri_b].data = NULL;                         \
+            (_heap)->buckets[_ri_b].size = 0;                            \
+            (_heap)->buckets[_ri_b].cap = 0;                             \
+        }                                                                \
+        (_heap)->mask = 0;                                               \
+        (_heap)->last = 0;                                               \
+        (_heap)->size = 0;                                               \
+    })
+
+/**
+ * \brief     A macro for freeing a radix heap.
+ * \note      This macro frees a radix heap using the allocator specified
+ *            when initializing the heap.
+ * \param[in] _heap The heap to free.
+ */
+#define radix_heap_free(_heap)                                                 \
+    ({                                                                         \
+        for (size_t _rfr_b = 0; _rfr_b < HR_RADIX_HEAP_BUCKETS; _rfr_b++)      \
+            if ((_heap)->buckets[_rfr_b].data != NULL)                         \
+                HR_DEALLOC((_heap)->allocator, (_heap)->buckets[_rfr_b].data); \
+    })
+
+// Getters
+
+/**
+ * \brief     A macro for getting the size of a radix heap.
+ * \param[in] _heap The heap to get the size of.
+ */
+#define radix_heap_get_size(_heap) ({ (_heap)->size; })
+
+/**
+ * \brief     A macro for getting the last popped key of a radix heap.
+ * \note      Keys lower than this one can no longer be pushed.
+ * \param[in] _heap The heap to get the last key of.
+ */
+#define radix_heap_get_last(_heap) ({ (_heap)->last; })
+
+// Setters
+
+/**
+ * \brief     A macro for setting the growth policy of a radix heap.
+ * \note      This macro sets the policy deciding how the buckets of a radix
+ *            heap grow. The policy is not copied and must outlive the heap.
+ * \param[in] _heap The heap to set the growth policy of.
+ * \param[in] _policy The growth policy to set the heap to.
+ */
+#define radix_heap_set_policy(_heap, _policy) ({ (_heap)->policy = (_policy); })
+
+/**
+ * \brief     A macro for checking if a radix heap is empty.
+ * \param[in] _heap The heap to check.
+ */
+#define radix_heap_empty(_heap) ({ (_heap)->size == 0; })
+
+/**
+ * \brief     A macro for pushing a value to a radix heap.
+ * \note      This macro pushes a value with the given key in O(1) time. The
+ *            key must not be lower than the last popped key, which holds for
+ *            monotone workloads such as Dijkstra's algorithm with non
+ *            negative integer weights or a simulation clock.
+ * \param[in] _heap The heap to push the value to.
+ * \param[in] _key The key of the value.
+ * \param[in] _value The value to push to the heap.
+ */
+#define radix_heap_push(_heap, _key, _value)                                 \
+    ({                                                                       \
+        _radix_heap_insert(_heap, ((typeof(*(_heap)->buckets[0].data)){      \
+                                      .key = (_key), .value = *(_value) })); \
+        (_heap)->size++;                                                     \
+    })
+
+/**
+ * \brief     A macro for getting the lowest key of a radix heap.
+ * \note      This macro does not pop the entry, but may move entries between
+ *            buckets. The heap must not be empty.
+ * \param[in] _heap The heap to get the lowest key of.
+ */
+#define radix_heap_peek_key(_heap) \
+    ({                             \
+        _radix_heap_refill(_heap); \
+        (_heap)->last;             \
+    })
+
+/**
+ * \brief     A macro for popping the entry with the lowest key of a radix
+ *            heap.
+ * \note      This macro pops an entry in amortised O(log C) time, where C is
+ *            the largest difference between a pushed key and the last popped
+ *            key. Entries with the same key are popped in no given order.
+ *            The heap must not be empty.
+ * \param[in] _heap The heap to pop the entry from.
+ * \return    The entry, with the key and the value.
+ */
+#define radix_heap_pop(_heap)                                 \
+    ({                                                        \
+        _radix_heap_refill(_heap);                            \
+        (_heap)->size--;                                      \
+        (_heap)->buckets[0].data[--(_heap)->buckets[0].size]; \
+    })
+
+#endif // HURUST_RADIX_HEAP_H
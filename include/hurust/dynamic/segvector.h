@@ -0,0 +1,341 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/*==========================================================================*
+
+  FILE
+    segvector.h
+
+  PROJECT
+    hurust generic library
+
+  DESCRIPTION
+    This file contains the segmented vector implementation, which grows by
+    adding chunks of doubling size instead of reallocating, so items never
+    move and pointers to them stay valid while the vector grows.
+
+  PROGRAMMER
+    Callum Gran.
+
+  MODIFICATIONS
+    18-Oct-26  C.Gran		Created file.
+
+ *==========================================================================*/
+#ifndef HURUST_SEG_VECTOR_H
+#define HURUST_SEG_VECTOR_H
+
+#include "../alloc.h"
+#include "../common.h"
+#include <stdbool.h>
+#include <stdlib.h>
+
+/**
+ * \brief     The maximum number of chunks of a segmented vector.
+ */
+#define HR_SEG_VECTOR_MAX_CHUNKS (sizeof(size_t) * 8)
+
+/**
+ * \brief     A macro for defining a segmented vector.
+ * \note      This macro defines a segmented vector with the given type and
+ *            struct prefix. Chunk k holds first_cap << k items, so the
+ *            capacity doubles with every chunk and an index is mapped to its
+ *            chunk with a single count leading zeros instruction.
+ * \param[in] type The type of the segmented vector.
+ * \param[in] struct_prefix The prefix for the segmented vector struct.
+ * \note      The struct prefix parameter is used to define the segmented
+ *            vector struct name as some types such as pointers and vectors
+ *            cannot be used as struct names.
+ */
+#define SEG_VECTOR(type, struct_prefix)           \
+    typedef struct struct_prefix##_seg_vector_t { \
+        type *chunks[HR_SEG_VECTOR_MAX_CHUNKS];   \
+        size_t nchunks;                           \
+        size_t first_shift;                       \
+        size_t size;                              \
+        size_t cap;                               \
+        int (*cmp)(const type, const type);       \
+        struct hr_allocator_t *allocator;         \
+    } struct_prefix##_seg_vector_t;
+
+/**
+ * \brief     Internal macro for getting the index of the highest set bit.
+ * \param[in] _x The non zero number to get the highest set bit of.
+ * \note      This macro is internal and should not be used.
+ */
+#define _seg_vector_log2(_x) ((size_t)(sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(_x)))
+
+/**
+ * \brief     Internal macro for getting a pointer to an item in a segmented
+ *            vector.
+ * \note      Index i lives at offset j - 2^k' in chunk k' - first_shift,
+ *            where j = i + first_cap and k' is the highest set bit of j.
+ * \param[in] _vector The segmented vector.
+ * \param[in] _i The index of the item.
+ * \note      This macro is internal and should not be used.
+ */
+#define _seg_vector_at(_vector, _i)                                        \
+    ({                                                                     \
+        const size_t _sa_j = (_i) + ((size_t)1 << (_vector)->first_shift); \
+        const size_t _sa_hi = _seg_vector_log2(_sa_j);                     \
+        &(_vector)->chunks[_sa_hi - (_vector)->first_shift]                \
+                          [_sa_j - ((size_t)1 << _sa_hi)];                 \
+    })
+
+/**
+ * \brief     Internal macro for adding a chunk to a segmented vector.
+ * \param[in] _vector The segmented vector to add a chunk to.
+ * \note      This macro is internal and should not be used.
+ */
+#define _seg_vector_add_chunk(_vector)                                                     \
+    ({                                                                                     \
+        const size_t _ac_len = (size_t)1 << ((_vector)->first_shift + (_vector)->nchunks); \
+        (_vector)->chunks[(_vector)->nchunks++] =                                          \
+            HR_ALLOC((_vector)->allocator, sizeof(**(_vector)->chunks) * _ac_len);         \
+        (_vector)->cap += _ac_len;                                                         \
+    })
+
+/**
+ * \brief     A macro for initializing a segmented vector.
+ * \note      This macro initializes a segmented vector with the given
+ *            allocator, size of the first chunk and comparison function. No
+ *            memory is allocated until the first item is pushed.
+ * \param[in] _vector The segmented vector to initialize.
+ * \param[in] _allocator The allocator to use for the chunks.
+ * \param[in] _first_cap The size of the first chunk, rounded up to a power of
+ *            two.
+ * \param[in] _cmp The comparison function for the items.
+ */
+#define seg_vector_init(_vector, _allocator, _first_cap, _cmp)        \
+    ({                                                                \
+        const size_t _si_first = (_first_cap);                        \
+        (_vector)->allocator = (_allocator);                          \
+        (_vector)->first_shift =                                      \
+            _si_first <= 1 ? 0 : _seg_vector_log2(_si_first - 1) + 1; \
+        (_vector)->nchunks = 0;                                       \
+        (_vector)->size = 0;                                          \
+        (_vector)->cap = 0;                                           \
+        (_vector)->cmp = (_cmp);                                      \
+    })
+
+/**
+ * \brief     A macro for freeing a segmented vector.
+ * \note      This macro frees every chunk of a segmented vector.
+ * \param[in] _vector The segmented vector to free.
+ */
+#define seg_vector_free(_vector)                                        \
+    ({                                                                  \
+        for (size_t _sf_k = 0; _sf_k < (_vector)->nchunks; _sf_k++)     \
+            HR_DEALLOC((_vector)->allocator, (_vector)->chunks[_sf_k]); \
+        (_vector)->nchunks = 0;                                         \
+        (_vector)->size = 0;                                            \
+        (_vector)->cap = 0;                                             \
+    })
+
+// Getters
+
+/**
+ * \brief     A macro for getting the size of a segmented vector.
+ * \param[in] _vector The segmented vector to get the size of.
+ */
+#define seg_vector_get_size(_vector) ({ (_vector)->size; })
+
+/**
+ * \brief     A macro for getting the capacity of a segmented vector.
+ * \param[in] _vector The segmented vector to get the capacity of.
+ */
+#define seg_vector_get_cap(_vector) ({ (_vector)->cap; })
+
+/**
+ * \brief     A macro for getting the comparison function of a segmented
+ *            vector.
+ * \param[in] _vector The segmented vector to get the comparison function of.
+ */
+#define seg_vector_get_cmp(_vector) ({ (_vector)->cmp; })
+
+// Methods
+
+/**
+ * \brief     A macro for checking if a segmented vector is empty.
+ * \param[in] _vector The segmented vector to check.
+ */
+#define seg_vector_empty(_vector) ({ (_vector)->size == 0; })
+
+/**
+ * \brief     A macro for reserving capacity in a segmented vector.
+ * \note      This macro adds chunks until the segmented vector can hold at
+ *            least _n more items. Existing items are never moved.
+ * \param[in] _vector The segmented vector to reserve capacity in.
+ * \param[in] _n The number of additional items to reserve capacity for.
+ */
+#define seg_vector_reserve(_vector, _n)                   \
+    ({                                                    \
+        const size_t _sr_needed = (_vector)->size + (_n); \
+        while ((_vector)->cap < _sr_needed)               \
+            _seg_vector_add_chunk(_vector);               \
+    })
+
+/**
+ * \brief     A macro for pushing an item to a segmented vector.
+ * \note      When the segmented vector is full a new chunk twice the size of
+ *            the last one is added. Items already in the vector stay where
+ *            they are.
+ * \param[in] _vector The segmented vector to push the item to.
+ * \param[in] _item The item to push to the segmented vector.
+ */
+#define seg_vector_push(_vector, _item)                       \
+    ({                                                        \
+        if ((_vector)->size == (_vector)->cap)                \
+            _seg_vector_add_chunk(_vector);                   \
+        *_seg_vector_at(_vector, (_vector)->size) = *(_item); \
+        (_vector)->size++;                                    \
+    })
+
+/**
+ * \brief     A macro for emplacing an item at the end of a segmented vector.
+ * \note      This macro adds an uninitialised slot at the end and returns a
+ *            pointer to it, so the item can be constructed in place. Like
+ *            every item pointer of a segmented vector, the pointer stays
+ *            valid while the vector grows.
+ * \param[in] _vector The segmented vector to emplace the item in.
+ * \return    A pointer to the new slot.
+ */
+#define seg_vector_emplace(_vector)                 \
+    ({                                              \
+        if ((_vector)->size == (_vector)->cap)      \
+            _seg_vector_add_chunk(_vector);         \
+        _seg_vector_at(_vector, (_vector)->size++); \
+    })
+
+/**
+ * \brief     A macro for popping the last item from a segmented vector.
+ * \note      Chunks are kept when the segmented vector shrinks, see
+ *            seg_vector_shrink_to_fit.
+ * \param[in] _vector The segmented vector to pop the item from.
+ */
+#define seg_vector_pop_back(_vector) ({ *_seg_vector_at(_vector, --(_vector)->size); })
+
+/**
+ * \brief     A macro for removing an item from a segmented vector without
+ *            preserving order.
+ * \note      This macro moves the last item into the place of the removed
+ *            one, which takes constant time.
+ * \param[in] _vector The segmented vector to remove the item from.
+ * \param[in] _i The index of the item to remove.
+ */
+#define seg_vector_swap_remove(_vector, _i)                     \
+    ({                                                          \
+        __auto_type _swap_p = _seg_vector_at(_vector, (_i));    \
+        __auto_type _swap_ret = *_swap_p;                       \
+        *_swap_p = *_seg_vector_at(_vector, --(_vector)->size); \
+        _swap_ret;                                              \
+    })
+
+/**
+ * \brief     A macro for getting an item from a segmented vector.
+ * \param[in] _vector The segmented vector to get the item from.
+ * \param[in] _i The index of the item to get.
+ */
+#define seg_vector_get(_vector, _i) ({ *_seg_vector_at(_vector, (_i)); })
+
+/**
+ * \brief     A macro for getting a pointer to an item in a segmented vector.
+ * \note      The pointer stays valid while the segmented vector grows, until
+ *            the item is removed or the segmented vector is shrunk or freed.
+ * \param[in] _vector The segmented vector to get the item pointer from.
+ * \param[in] _i The index of the item to get the pointer of.
+ */
+#define seg_vector_get_ptr(_vector, _i) ({ _seg_vector_at(_vector, (_i)); })
+
+/**
+ * \brief     A macro for setting an item in a segmented vector.
+ * \param[in] _vector The segmented vector to set the item in.
+ * \param[in] _item The item to set in the segmented vector.
+ * \param[in] _i The index of the item to set.
+ */
+#define seg_vector_set(_vector, _item, _i) ({ *_seg_vector_at(_vector, (_i)) = *(_item); })
+
+/**
+ * \brief     A macro for freeing the chunks a segmented vector no longer uses.
+ * \note      Only chunks holding no items are freed, so pointers to items in
+ *            the segmented vector stay valid.
+ * \param[in] _vector The segmented vector to shrink.
+ */
+#define seg_vector_shrink_to_fit(_vector)                                                \
+    ({                                                                                   \
+        while ((_vector)->nchunks > 0) {                                                 \
+            const size_t _sk_len = (size_t)1                                             \
+                                   << ((_vector)->first_shift + (_vector)->nchunks - 1); \
+            if ((_vector)->cap - _sk_len < (_vector)->size)                              \
+                break;                                                                   \
+            HR_DEALLOC((_vector)->allocator, (_vector)->chunks[--(_vector)->nchunks]);   \
+            (_vector)->cap -= _sk_len;                                                   \
+        }                                                                                \
+    })
+
+/**
+ * \brief     Internal macro for finding the item in a segmented vector that
+ *            compares best by the given comparison operator.
+ * \param[in] _vector The segmented vector to search.
+ * \param[in] _op The operator the comparison result is tested with against 0.
+ * \note      This macro is internal and should not be used.
+ */
+#define _seg_vector_best(_vector, _op)                                            \
+    ({                                                                            \
+        __auto_type _best = (_vector)->chunks[0][0];                              \
+        size_t _be_left = (_vector)->size;                                        \
+        for (size_t _be_k = 0; _be_left > 0; _be_k++) {                           \
+            size_t _be_len = (size_t)1 << ((_vector)->first_shift + _be_k);       \
+            _be_len = _be_len < _be_left ? _be_len : _be_left;                    \
+            for (size_t _be_i = 0; _be_i < _be_len; _be_i++)                      \
+                if ((_vector)->cmp((_vector)->chunks[_be_k][_be_i], _best) _op 0) \
+                    _best = (_vector)->chunks[_be_k][_be_i];                      \
+            _be_left -= _be_len;                                                  \
+        }                                                                         \
+        _best;                                                                    \
+    })
+
+/**
+ * \brief     A macro for getting the maximum item in a segmented vector.
+ * \param[in] _vector The segmented vector to get the maximum item from.
+ */
+#define seg_vector_max(_vector) _seg_vector_best(_vector, >)
+
+/**
+ * \brief     A macro for getting the minimum item in a segmented vector.
+ * \param[in] _vector The segmented vector to get the minimum item from.
+ */
+#define seg_vector_min(_vector) _seg_vector_best(_vector, <)
+
+/**
+ * \brief     A macro for performing a for each loop on a segmented vector.
+ * \note      The items are visited chunk by chunk, so the loop runs over
+ *            contiguous memory without mapping every index.
+ * \param[in] _vector The segmented vector to perform the for each loop on.
+ * \param[in] _func The function to perform on a pointer to each item.
+ */
+#define seg_vector_foreach(_vector, _func)                                  \
+    ({                                                                      \
+        size_t _fe_left = (_vector)->size;                                  \
+        for (size_t _fe_k = 0; _fe_left > 0; _fe_k++) {                     \
+            size_t _fe_len = (size_t)1 << ((_vector)->first_shift + _fe_k); \
+            _fe_len = _fe_len < _fe_left ? _fe_len : _fe_left;              \
+            for (size_t _fe_i = 0; _fe_i < _fe_len; _fe_i++)                \
+                _func(&(_vector)->chunks[_fe_k][_fe_i]);                    \
+            _fe_left -= _fe_len;                                            \
+        }                                                                   \
+    })
+
+#endif // HURUST_SEG_VECTOR_H
@@ -0,0 +1,351 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/*==========================================================================*
+
+  FILE
+    smallvector.h
+
+  PROJECT
+    hurust generic library
+
+  DESCRIPTION
+    This file contains the small vector implementation, which is a dynamic
+    array that stores its first items inside the structure itself and only
+    uses the allocator once it outgrows that inline storage.
+
+  PROGRAMMER
+    Callum Gran.
+
+  MODIFICATIONS
+    18-Oct-26  C.Gran		Created file.
+
+ *==========================================================================*/
+#ifndef HURUST_SMALL_VECTOR_H
+#define HURUST_SMALL_VECTOR_H
+
+#include "../alloc.h"
+#include "../common.h"
+#include "../sort.h"
+#include "vector.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief     A macro for defining a small vector.
+ * \note      This macro defines a small vector with the given type, struct
+ *            prefix and inline capacity. The first n items are stored
+ *            inside the struct, so a small vector holding at most n items
+ *            never calls the allocator.
+ * \param[in] type The type of the small vector.
+ * \param[in] struct_prefix The prefix for the small vector struct.
+ * \param[in] n The number of items stored inline.
+ * \note      The struct prefix parameter is used to define the small vector
+ *            struct name as some types such as pointers and vectors cannot be
+ *            used as struct names.
+ * \note      While the items are inline the data pointer points into the
+ *            struct itself, so a small vector must not be copied by value.
+ */
+#define SMALL_VECTOR(type, struct_prefix, n)        \
+    typedef struct struct_prefix##_small_vector_t { \
+        type *data;                                 \
+        size_t size;                                \
+        size_t cap;                                 \
+        int (*cmp)(const type, const type);         \
+        struct hr_allocator_t *allocator;           \
+        const struct hr_growth_policy_t *policy;    \
+        type inline_data[n];                        \
+    } struct_prefix##_small_vector_t;
+
+/**
+ * \brief     A macro for initializing a small vector.
+ * \note      This macro initializes a small vector with the given allocator
+ *            and comparison function for sorting and searching. No memory
+ *            is allocated until the inline storage is full.
+ * \param[in] _vector The small vector to initialize.
+ * \param[in] _allocator The allocator to use once the small vector outgrows
+ *            its inline storage.
+ * \param[in] _cmp The comparison function for sorting and searching.
+ */
+#define small_vector_init(_vector, _allocator, _cmp)                                       \
+    ({                                                                                     \
+        (_vector)->allocator = (_allocator);                                               \
+        (_vector)->policy = HR_DEFAULT_GROWTH_POLICY;                                      \
+        (_vector)->cap = sizeof((_vector)->inline_data) / sizeof(*(_vector)->inline_data); \
+        (_vector)->size = 0;                                                               \
+        (_vector)->cmp = (_cmp);                                                           \
+        (_vector)->data = (_vector)->inline_data;                                          \
+    })
+
+/**
+ * \brief     A macro for checking if a small vector still uses its inline
+ *            storage.
+ * \param[in] _vector The small vector to check.
+ */
+#define small_vector_is_inline(_vector) ({ (_vector)->data == (_vector)->inline_data; })
+
+/**
+ * \brief     A macro for freeing a small vector.
+ * \note      This macro frees the memory of a small vector if it has
+ *            outgrown its inline storage.
+ * \param[in] _vector The small vector to free.
+ */
+#define small_vector_free(_vector)                             \
+    ({                                                         \
+        if (!small_vector_is_inline(_vector))                  \
+            HR_DEALLOC((_vector)->allocator, (_vector)->data); \
+    })
+
+/**
+ * \brief     Internal macro for ensuring a small vector can hold the given
+ *            number of items.
+ * \note      The first time the inline storage overflows, the items are
+ *            moved to a buffer from the allocator. After that the buffer
+ *            grows like a vector.
+ * \param[in] _vector The small vector to ensure capacity for.
+ * \param[in] _n The number of items the small vector must be able to hold.
+ * \note      This macro is internal and should not be used.
+ */
+#define _small_vector_reserve(_vector, _n)                                                     \
+    ({                                                                                         \
+        const size_t _sv_n = (_n);                                                             \
+        if ((_vector)->cap < _sv_n) {                                                          \
+            if (small_vector_is_inline(_vector)) {                                             \
+                (_vector)->cap = _policy_grow_cap((_vector)->policy, (_vector)->cap, _sv_n);   \
+                (_vector)->data =                                                              \
+                    HR_ALLOC((_vector)->allocator, sizeof(*(_vector)->data) * (_vector)->cap); \
+                memcpy((_vector)->data, (_vector)->inline_data,                                \
+                       sizeof(*(_vector)->data) * (_vector)->size);                            \
+            } else {                                                                           \
+                _reserve_cap(_vector, _sv_n);                                                  \
+            }                                                                                  \
+        }                                                                                      \
+    })
+
+// Getters
+
+/**
+ * \brief     A macro for getting the size of a small vector.
+ * \param[in] _vector The small vector to get the size of.
+ */
+#define small_vector_get_size(_vector) vector_get_size(_vector)
+
+/**
+ * \brief     A macro for getting the capacity of a small vector.
+ * \param[in] _vector The small vector to get the capacity of.
+ */
+#define small_vector_get_cap(_vector) vector_get_cap(_vector)
+
+/**
+ * \brief     A macro for getting the data of a small vector.
+ * \param[in] _vector The small vector to get the data of.
+ */
+#define small_vector_get_data(_vector) vector_get_data(_vector)
+
+// Setters
+
+/**
+ * \brief     A macro for setting the growth policy of a small vector.
+ * \note      The policy is used once the small vector outgrows its inline
+ *            storage. The policy is not copied and must outlive the small
+ *            vector.
+ * \param[in] _vector The small vector to set the growth policy of.
+ * \param[in] _policy The growth policy to set the small vector to.
+ */
+#define small_vector_set_policy(_vector, _policy) vector_set_policy(_vector, _policy)
+
+// Methods
+
+/**
+ * \brief     A macro for checking if a small vector is empty.
+ * \param[in] _vector The small vector to check.
+ */
+#define small_vector_empty(_vector) vector_empty(_vector)
+
+/**
+ * \brief     A macro for reserving capacity in a small vector.
+ * \note      This macro ensures the small vector can hold at least _n more
+ *            items without growing.
+ * \param[in] _vector The small vector to reserve capacity in.
+ * \param[in] _n The number of additional items to reserve capacity for.
+ */
+#define small_vector_reserve(_vector, _n) _small_vector_reserve(_vector, (_vector)->size + (_n))
+
+/**
+ * \brief     A macro for pushing an item to a small vector.
+ * \param[in] _vector The small vector to push the item to.
+ * \param[in] _item The item to push to the small vector.
+ */
+#define small_vector_push(_vector, _item)                    \
+    ({                                                       \
+        _small_vector_reserve(_vector, (_vector)->size + 1); \
+        (_vector)->data[(_vector)->size] = *(_item);         \
+        (_vector)->size++;                                   \
+    })
+
+/**
+ * \brief     A macro for emplacing an item at the end of a small vector.
+ * \note      This macro adds an uninitialised slot at the end and returns a
+ *            pointer to it, so the item can be constructed in place. The
+ *            slot must be written before the small vector is used again.
+ * \param[in] _vector The small vector to emplace the item in.
+ * \return    A pointer to the new slot.
+ */
+#define small_vector_emplace(_vector)                        \
+    ({                                                       \
+        _small_vector_reserve(_vector, (_vector)->size + 1); \
+        &(_vector)->data[(_vector)->size++];                 \
+    })
+
+/**
+ * \brief     A macro for popping an item from a small vector.
+ * \note      This macro pops the item at the given index, shifting the
+ *            following items down. The capacity is kept.
+ * \param[in] _vector The small vector to pop the item from.
+ * \param[in] _i The index of the item to pop.
+ */
+#define small_vector_pop(_vector, _i)                                   \
+    ({                                                                  \
+        const size_t _pop_i = (_i);                                     \
+        _typeofarray((_vector)->data) _ret = (_vector)->data[_pop_i];   \
+        (_vector)->size--;                                              \
+        memmove((_vector)->data + _pop_i, (_vector)->data + _pop_i + 1, \
+                sizeof(*(_vector)->data) * ((_vector)->size - _pop_i)); \
+        _ret;                                                           \
+    })
+
+/**
+ * \brief     A macro for removing an item from a small vector without
+ *            preserving order.
+ * \note      This macro moves the last item into the place of the removed
+ *            one, which takes constant time. The capacity is kept.
+ * \param[in] _vector The small vector to remove the item from.
+ * \param[in] _i The index of the item to remove.
+ */
+#define small_vector_swap_remove(_vector, _i)                          \
+    ({                                                                 \
+        const size_t _swap_i = (_i);                                   \
+        _typeofarray((_vector)->data) _ret = (_vector)->data[_swap_i]; \
+        (_vector)->data[_swap_i] = (_vector)->data[--(_vector)->size]; \
+        _ret;                                                          \
+    })
+
+/**
+ * \brief     A macro for keeping only the items of a small vector that match
+ *            a predicate.
+ * \note      The capacity is kept.
+ * \param[in] _vector The small vector to filter.
+ * \param[in] _pred The predicate, called with a pointer to each item and
+ *            returning true for items to keep.
+ * \return    The number of items removed.
+ */
+#define small_vector_retain(_vector, _pred)                                \
+    ({                                                                     \
+        const size_t _ret_old = (_vector)->size;                           \
+        (_vector)->size = _retain_items((_vector)->data, _ret_old, _pred); \
+        _ret_old - (_vector)->size;                                        \
+    })
+
+/**
+ * \brief     A macro for removing adjacent duplicate items from a small
+ *            vector.
+ * \note      The capacity is kept.
+ * \param[in] _vector The small vector to deduplicate.
+ * \return    The number of items removed.
+ */
+#define small_vector_dedup(_vector)                                                  \
+    ({                                                                               \
+        const size_t _dedup_old = (_vector)->size;                                   \
+        (_vector)->size = _dedup_items((_vector)->data, _dedup_old, (_vector)->cmp); \
+        _dedup_old - (_vector)->size;                                                \
+    })
+
+/**
+ * \brief     A macro for getting an item from a small vector.
+ * \param[in] _vector The small vector to get the item from.
+ * \param[in] _i The index of the item to get.
+ */
+#define small_vector_get(_vector, _i) vector_get(_vector, _i)
+
+/**
+ * \brief     A macro for setting an item in a small vector.
+ * \param[in] _vector The small vector to set the item in.
+ * \param[in] _item The item to set in the small vector.
+ * \param[in] _i The index of the item to set.
+ */
+#define small_vector_set(_vector, _item, _i) vector_set(_vector, _item, _i)
+
+/**
+ * \brief     A macro for sorting a small vector.
+ * \note      This macro sorts a small vector using the comparison function
+ *            specified when initializing the small vector.
+ * \param[in] _vector The small vector to sort.
+ */
+#define small_vector_sort(_vector) vector_sort(_vector)
+
+/**
+ * \brief     A macro for sorting a small vector of primitive types in
+ *            ascending order.
+ * \param[in] _vector The small vector to sort.
+ */
+#define small_vector_sort_natural(_vector) vector_sort_natural(_vector)
+
+/**
+ * \brief     A macro for finding the first position in a sorted small vector
+ *            whose item is not less than the given item.
+ * \param[in] _vector The sorted small vector to search.
+ * \param[in] _item The item to search for.
+ */
+#define small_vector_lower_bound(_vector, _item) vector_lower_bound(_vector, _item)
+
+/**
+ * \brief     A macro for finding the first position in a sorted small vector
+ *            whose item is greater than the given item.
+ * \param[in] _vector The sorted small vector to search.
+ * \param[in] _item The item to search for.
+ */
+#define small_vector_upper_bound(_vector, _item) vector_upper_bound(_vector, _item)
+
+/**
+ * \brief     A macro for binary searching a sorted small vector.
+ * \param[in] _vector The sorted small vector to search.
+ * \param[in] _item The item to search for.
+ * \return    The index of the first item equal to _item, or -1 if the item is
+ *            not in the small vector.
+ */
+#define small_vector_bsearch(_vector, _item) vector_bsearch(_vector, _item)
+
+/**
+ * \brief     A macro for getting the maximum item in a small vector.
+ * \param[in] _vector The small vector to get the maximum item from.
+ */
+#define small_vector_max(_vector) vector_max(_vector)
+
+/**
+ * \brief     A macro for getting the minimum item in a small vector.
+ * \param[in] _vector The small vector to get the minimum item from.
+ */
+#define small_vector_min(_vector) vector_min(_vector)
+
+/**
+ * \brief     A macro for performing a for each loop on a small vector.
+ * \param[in] _vector The small vector to perform the for each loop on.
+ * \param[in] _func The function to perform on each item in the small vector.
+ */
+#define small_vector_foreach(_vector, _func) vector_foreach(_vector, _func)
+
+#endif // HURUST_SMALL_VECTOR_H
@@ -0,0 +1,381 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/*==========================================================================*
+
+  FILE
+    soavector.h
+
+  PROJECT
+    hurust generic library
+
+  DESCRIPTION
+    This file contains the struct of arrays vector implementation, which
+    stores every field of a record in its own contiguous column so loops
+    touching few fields only load the columns they use.
+
+  PROGRAMMER
+    Callum Gran.
+
+  MODIFICATIONS
+    18-Oct-26  C.Gran		Created file.
+
+ *==========================================================================*/
+#ifndef HURUST_SOA_VECTOR_H
+#define HURUST_SOA_VECTOR_H
+
+#include "../alloc.h"
+#include "../common.h"
+#include "../sort.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief     The alignment in bytes of every column in the shared buffer.
+ * \note      The buffer is aligned to it and every column is rounded up to
+ *            it, so every column starts on its own cache line and two
+ *            columns never share one.
+ */
+#define HR_SOA_COLUMN_ALIGN 64
+
+#define _SOA_ROW_FIELD(type, name) type name;
+#define _SOA_COLUMN_FIELD(type, name) type *name;
+#define _SOA_COUNT_FIELD(type, name) +1
+#define _SOA_INIT_FIELD(type, name) _soa_init->sizes[_soa_init_c++] = sizeof(type);
+#define _SOA_STORE_FIELD(type, name) _soa_st->col.name[_soa_st_i] = _soa_st_row->name;
+#define _SOA_LOAD_FIELD(type, name) _soa_ld_row.name = _soa_ld->col.name[_soa_ld_i];
+#define _SOA_MOVE_FIELD(type, name) _soa_mv->col.name[_soa_mv_to] = _soa_mv->col.name[_soa_mv_from];
+
+/**
+ * \brief     A macro for defining a struct of arrays vector.
+ * \note      This macro defines a struct of arrays vector with one column per
+ *            field in the given field list, together with a row struct
+ *            holding one item of every column. The field list is an X-macro
+ *            taking a macro and calling it with the type and name of every
+ *            field:
+ *
+ *            #define POINT_FIELDS(X) X(float, x) X(float, y) X(int, id)
+ *            SOA_VECTOR(POINT_FIELDS, point);
+ *
+ *            The columns are reached by name through the col member, e.g.
+ *            vector.col.x is a float pointer to the x column. The macros
+ *            that move whole rows take the same field list, so every field
+ *            is copied by a plain typed assignment.
+ * \param[in] fields The X-macro field list of the struct of arrays vector.
+ * \param[in] struct_prefix The prefix for the struct of arrays vector and row
+ *            structs.
+ * \note      All columns share one buffer, so growing the vector takes one
+ *            allocation no matter how many fields it has.
+ */
+#define SOA_VECTOR(fields, struct_prefix)            \
+    typedef struct struct_prefix##_soa_row_t {       \
+        fields(_SOA_ROW_FIELD)                       \
+    } struct_prefix##_soa_row_t;                     \
+    typedef struct struct_prefix##_soa_vector_t {    \
+        union {                                      \
+            struct {                                 \
+                fields(_SOA_COLUMN_FIELD)            \
+            } col;                                   \
+            void *_cols[0 fields(_SOA_COUNT_FIELD)]; \
+        };                                           \
+        size_t sizes[0 fields(_SOA_COUNT_FIELD)];    \
+        void *raw;                                   \
+        size_t size;                                 \
+        size_t cap;                                  \
+        struct hr_allocator_t *allocator;            \
+        const struct hr_growth_policy_t *policy;     \
+        struct_prefix##_soa_row_t _row_type[0];      \
+    } struct_prefix##_soa_vector_t;
+
+/**
+ * \brief     Internal macro for getting the number of columns of a struct of
+ *            arrays vector.
+ * \param[in] _soa The struct of arrays vector.
+ * \note      This macro is internal and should not be used.
+ */
+#define _soa_vector_ncols(_soa) (sizeof((_soa)->_cols) / sizeof(*(_soa)->_cols))
+
+/**
+ * \brief     Internal macro for getting the address of an item in a column.
+ * \param[in] _soa The struct of arrays vector.
+ * \param[in] _c The index of the column.
+ * \param[in] _i The index of the item.
+ * \note      This macro is internal and should not be used.
+ */
+#define _soa_vector_at(_soa, _c, _i) ((char *)(_soa)->_cols[(_c)] + (_i) * (_soa)->sizes[(_c)])
+
+/**
+ * \brief     Internal macro for moving a struct of arrays vector to a buffer
+ *            of the given capacity.
+ * \note      The new buffer is taken from the allocator in a single call
+ *            and holds every column. The allocator only aligns to the
+ *            fundamental alignment, so one extra HR_SOA_COLUMN_ALIGN bytes are
+ *            taken and the first column starts at the first aligned address,
+ *            the raw pointer being kept for the free. The items are copied
+ *            over and the old buffer is freed.
+ * \param[in] _soa The struct of arrays vector to move.
+ * \param[in] _cap The new capacity of the struct of arrays vector.
+ * \note      This macro is internal and should not be used.
+ */
+#define _soa_vector_set_cap(_soa, _cap)                                                     \
+    ({                                                                                      \
+        const size_t _sc_cap = (_cap);                                                      \
+        size_t _sc_total = 0;                                                               \
+        for (size_t _sc_c = 0; _sc_c < _soa_vector_ncols(_soa); _sc_c++)                    \
+            _sc_total += ((_soa)->sizes[_sc_c] * _sc_cap + HR_SOA_COLUMN_ALIGN - 1) &       \
+                         ~(size_t)(HR_SOA_COLUMN_ALIGN - 1);                                \
+        void *_sc_old = (_soa)->raw;                                                        \
+        (_soa)->raw = HR_ALLOC((_soa)->allocator, _sc_total + HR_SOA_COLUMN_ALIGN);         \
+        char *_sc_buf = (char *)(((uintptr_t)(_soa)->raw + HR_SOA_COLUMN_ALIGN - 1) &       \
+                                 ~(uintptr_t)(HR_SOA_COLUMN_ALIGN - 1));                    \
+        for (size_t _sc_c = 0; _sc_c < _soa_vector_ncols(_soa); _sc_c++) {                  \
+            if ((_soa)->size > 0)                                                           \
+                memcpy(_sc_buf, (_soa)->_cols[_sc_c], (_soa)->sizes[_sc_c] * (_soa)->size); \
+            (_soa)->_cols[_sc_c] = _sc_buf;                                                 \
+            _sc_buf += ((_soa)->sizes[_sc_c] * _sc_cap + HR_SOA_COLUMN_ALIGN - 1) &         \
+                       ~(size_t)(HR_SOA_COLUMN_ALIGN - 1);                                  \
+        }                                                                                   \
+        (_soa)->cap = _sc_cap;                                                              \
+        if (_sc_old != NULL)                                                                \
+            HR_DEALLOC((_soa)->allocator, _sc_old);                                         \
+    })
+
+/**
+ * \brief     A macro for initializing a struct of arrays vector.
+ * \note      This macro initializes a struct of arrays vector with the given
+ *            allocator and capacity. The field list must be the one the
+ *            struct of arrays vector was defined with.
+ * \param[in] _soa The struct of arrays vector to initialize.
+ * \param[in] fields The X-macro field list of the struct of arrays vector.
+ * \param[in] _allocator The allocator to use for the struct of arrays vector.
+ * \param[in] _cap The initial capacity of the struct of arrays vector.
+ */
+#define soa_vector_init(_soa, fields, _allocator, _cap) \
+    ({                                                  \
+        __auto_type _soa_init = (_soa);                 \
+        size_t _soa_init_c = 0;                         \
+        fields(_SOA_INIT_FIELD);                        \
+        _soa_init->allocator = (_allocator);            \
+        _soa_init->policy = HR_DEFAULT_GROWTH_POLICY;   \
+        _soa_init->size = 0;                            \
+        _soa_init->raw = NULL;                          \
+        _soa_vector_set_cap(_soa_init, (_cap));         \
+    })
+
+/**
+ * \brief     A macro for freeing a struct of arrays vector.
+ * \note      This macro frees the shared buffer of all the columns.
+ * \param[in] _soa The struct of arrays vector to free.
+ */
+#define soa_vector_free(_soa) ({ HR_DEALLOC((_soa)->allocator, (_soa)->raw); })
+
+// Getters
+
+/**
+ * \brief     A macro for getting the size of a struct of arrays vector.
+ * \param[in] _soa The struct of arrays vector to get the size of.
+ */
+#define soa_vector_get_size(_soa) ({ (_soa)->size; })
+
+/**
+ * \brief     A macro for getting the capacity of a struct of arrays vector.
+ * \param[in] _soa The struct of arrays vector to get the capacity of.
+ */
+#define soa_vector_get_cap(_soa) ({ (_soa)->cap; })
+
+/**
+ * \brief     A macro for getting a column of a struct of arrays vector.
+ * \note      The returned pointer is invalidated when the struct of arrays
+ *            vector grows.
+ * \param[in] _soa The struct of arrays vector to get the column of.
+ * \param[in] _field The name of the field to get the column of.
+ */
+#define soa_vector_get_column(_soa, _field) ({ (_soa)->col._field; })
+
+// Setters
+
+/**
+ * \brief     A macro for setting the growth policy of a struct of arrays
+ *            vector.
+ * \note      The policy is not copied and must outlive the struct of arrays
+ *            vector.
+ * \param[in] _soa The struct of arrays vector to set the growth policy of.
+ * \param[in] _policy The growth policy to set the struct of arrays vector to.
+ */
+#define soa_vector_set_policy(_soa, _policy) ({ (_soa)->policy = (_policy); })
+
+// Methods
+
+/**
+ * \brief     A macro for checking if a struct of arrays vector is empty.
+ * \param[in] _soa The struct of arrays vector to check.
+ */
+#define soa_vector_empty(_soa) ({ (_soa)->size == 0; })
+
+/**
+ * \brief     A macro for reserving capacity in a struct of arrays vector.
+ * \note      This macro ensures the struct of arrays vector can hold at
+ *            least _n more items without growing.
+ * \param[in] _soa The struct of arrays vector to reserve capacity in.
+ * \param[in] _n The number of additional items to reserve capacity for.
+ */
+#define soa_vector_reserve(_soa, _n)                                                              \
+    ({                                                                                            \
+        const size_t _rs_needed = (_soa)->size + (_n);                                            \
+        if ((_soa)->cap < _rs_needed)                                                             \
+            _soa_vector_set_cap(_soa, _policy_grow_cap((_soa)->policy, (_soa)->cap, _rs_needed)); \
+    })
+
+/**
+ * \brief     A macro for pushing a row to a struct of arrays vector.
+ * \note      Every field of the row is appended to its column. The field list
+ *            must be the one the struct of arrays vector was defined with.
+ * \param[in] _soa The struct of arrays vector to push the row to.
+ * \param[in] fields The X-macro field list of the struct of arrays vector.
+ * \param[in] _row A pointer to the row struct to push.
+ */
+#define soa_vector_push(_soa, fields, _row)                      \
+    ({                                                           \
+        __auto_type _soa_st = (_soa);                            \
+        const typeof(*_soa_st->_row_type) *_soa_st_row = (_row); \
+        soa_vector_reserve(_soa_st, 1);                          \
+        const size_t _soa_st_i = _soa_st->size;                  \
+        fields(_SOA_STORE_FIELD);                                \
+        _soa_st->size++;                                         \
+    })
+
+/**
+ * \brief     A macro for getting a row from a struct of arrays vector.
+ * \note      This macro gathers the item at the given index from every
+ *            column into a row struct. The field list must be the one the
+ *            struct of arrays vector was defined with.
+ * \param[in] _soa The struct of arrays vector to get the row from.
+ * \param[in] fields The X-macro field list of the struct of arrays vector.
+ * \param[in] _i The index of the row to get.
+ */
+#define soa_vector_get(_soa, fields, _i)         \
+    ({                                           \
+        __auto_type _soa_ld = (_soa);            \
+        const size_t _soa_ld_i = (_i);           \
+        typeof(*_soa_ld->_row_type) _soa_ld_row; \
+        fields(_SOA_LOAD_FIELD);                 \
+        _soa_ld_row;                             \
+    })
+
+/**
+ * \brief     A macro for setting a row in a struct of arrays vector.
+ * \note      The field list must be the one the struct of arrays vector was
+ *            defined with.
+ * \param[in] _soa The struct of arrays vector to set the row in.
+ * \param[in] fields The X-macro field list of the struct of arrays vector.
+ * \param[in] _row A pointer to the row struct to set.
+ * \param[in] _i The index of the row to set.
+ */
+#define soa_vector_set(_soa, fields, _row, _i)                   \
+    ({                                                           \
+        __auto_type _soa_st = (_soa);                            \
+        const typeof(*_soa_st->_row_type) *_soa_st_row = (_row); \
+        const size_t _soa_st_i = (_i);                           \
+        fields(_SOA_STORE_FIELD);                                \
+    })
+
+/**
+ * \brief     A macro for getting one field of a row in a struct of arrays
+ *            vector.
+ * \note      Only the column of the given field is read.
+ * \param[in] _soa The struct of arrays vector to get the field from.
+ * \param[in] _field The name of the field to get.
+ * \param[in] _i The index of the row to get the field of.
+ */
+#define soa_vector_get_field(_soa, _field, _i) ({ (_soa)->col._field[(_i)]; })
+
+/**
+ * \brief     A macro for setting one field of a row in a struct of arrays
+ *            vector.
+ * \param[in] _soa The struct of arrays vector to set the field in.
+ * \param[in] _field The name of the field to set.
+ * \param[in] _item A pointer to the value to set the field to.
+ * \param[in] _i The index of the row to set the field of.
+ */
+#define soa_vector_set_field(_soa, _field, _item, _i) ({ (_soa)->col._field[(_i)] = *(_item); })
+
+/**
+ * \brief     A macro for removing a row from a struct of arrays vector without
+ *            preserving order.
+ * \note      This macro moves the last row into the place of the removed one
+ *            in every column, which takes constant time. The field list must
+ *            be the one the struct of arrays vector was defined with.
+ * \param[in] _soa The struct of arrays vector to remove the row from.
+ * \param[in] fields The X-macro field list of the struct of arrays vector.
+ * \param[in] _i The index of the row to remove.
+ * \return    The removed row.
+ */
+#define soa_vector_swap_remove(_soa, fields, _i)         \
+    ({                                                   \
+        __auto_type _soa_mv = (_soa);                    \
+        const size_t _soa_mv_to = (_i);                  \
+        typeof(*_soa_mv->_row_type) _soa_mv_ret =        \
+            soa_vector_get(_soa_mv, fields, _soa_mv_to); \
+        const size_t _soa_mv_from = --_soa_mv->size;     \
+        fields(_SOA_MOVE_FIELD);                         \
+        _soa_mv_ret;                                     \
+    })
+
+/**
+ * \brief     A macro for sorting a struct of arrays vector by one field.
+ * \note      The order is computed from the column of the given field alone
+ *            with argsort and is then applied to every column, so rows stay
+ *            together. Rows with equal fields keep their relative order.
+ * \param[in] _soa The struct of arrays vector to sort.
+ * \param[in] _field The name of the field to sort by.
+ * \param[in] _cmp The comparison function for the type of the field.
+ */
+#define soa_vector_sort_by(_soa, _field, _cmp)                                                   \
+    ({                                                                                           \
+        const size_t _sb_n = (_soa)->size;                                                       \
+        size_t _sb_max = 0;                                                                      \
+        for (size_t _sb_c = 0; _sb_c < _soa_vector_ncols(_soa); _sb_c++)                         \
+            _sb_max = (_soa)->sizes[_sb_c] > _sb_max ? (_soa)->sizes[_sb_c] : _sb_max;           \
+        size_t *_sb_idx = HR_ALLOC((_soa)->allocator, sizeof(size_t) * _sb_n + _sb_max * _sb_n); \
+        char *_sb_tmp = (char *)(_sb_idx + _sb_n);                                               \
+        argsort((_soa)->col._field, _sb_n, _cmp, _sb_idx);                                       \
+        for (size_t _sb_c = 0; _sb_c < _soa_vector_ncols(_soa); _sb_c++) {                       \
+            const size_t _sb_sz = (_soa)->sizes[_sb_c];                                          \
+            for (size_t _sb_i = 0; _sb_i < _sb_n; _sb_i++)                                       \
+                memcpy(_sb_tmp + _sb_i * _sb_sz, _soa_vector_at(_soa, _sb_c, _sb_idx[_sb_i]),    \
+                       _sb_sz);                                                                  \
+            memcpy((_soa)->_cols[_sb_c], _sb_tmp, _sb_sz * _sb_n);                               \
+        }                                                                                        \
+        HR_DEALLOC((_soa)->allocator, _sb_idx);                                                  \
+    })
+
+/**
+ * \brief     A macro for performing a for each loop on one column of a struct
+ *            of arrays vector.
+ * \param[in] _soa The struct of arrays vector to perform the loop on.
+ * \param[in] _field The name of the field whose column is looped over.
+ * \param[in] _func The function to perform on a pointer to each field.
+ */
+#define soa_vector_foreach_field(_soa, _field, _func)         \
+    ({                                                        \
+        for (size_t _fe_i = 0; _fe_i < (_soa)->size; _fe_i++) \
+            _func(&(_soa)->col._field[_fe_i]);                \
+    })
+
+#endif // HURUST_SOA_VECTOR_H
@@ -40,6 +40,8 @@
 #include "../sort.h"
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
 
 /**
  * \brief     A macro for defining a vector.
@@ -50,13 +52,14 @@
  *            name as some types such as pointers and vectors cannot be used
  *            as struct names.
  */
-#define VECTOR(type, struct_prefix)           \
-    typedef struct struct_prefix##_vector_t { \
-        type *data;                           \
-        size_t size;                          \
-        size_t cap;                           \
-        int (*cmp)(const type, const type);   \
-        struct hr_allocator_t *allocator;     \
+#define VECTOR(type, struct_prefix)              \
+    typedef struct struct_prefix##_vector_t {    \
+        type *data;                              \
+        size_t size;                             \
+        size_t cap;                              \
+        int (*cmp)(const type, const type);      \
+        struct hr_allocator_t *allocator;        \
+        const struct hr_growth_policy_t *policy; \
     } struct_prefix##_vector_t;
 
 /**
@@ -71,6 +74,7 @@
 #define vector_init(_vector, _allocator, _cap, _cmp)                                   \
     ({                                                                                 \
         (_vector)->allocator = (_allocator);                                           \
+        (_vector)->policy = HR_DEFAULT_GROWTH_POLICY;                                  \
         (_vector)->cap = (_cap);                                                       \
         (_vector)->size = 0;                                                           \
         (_vector)->cmp = (_cmp);                                                       \
@@ -123,6 +127,13 @@
  */
 #define vector_get_allocator(_vector) ({ (_vector)->cmp; })
 
+/**
+ * \brief     A macro for getting the growth policy of a vector.
+ * \note      This macro gets the growth policy of a vector.
+ * \param[in] _vector The vector to get the growth policy of.
+ */
+#define vector_get_policy(_vector) ({ (_vector)->policy; })
+
 // Setters
 
 /**
@@ -165,6 +176,15 @@
  */
 #define vector_set_allocator(_vector, _allocator) ({ (_vector)->allocator = (_allocator); })
 
+/**
+ * \brief     A macro for setting the growth policy of a vector.
+ * \note      This macro sets the policy deciding how a vector grows and
+ *            shrinks. The policy is not copied and must outlive the vector.
+ * \param[in] _vector The vector to set the growth policy of.
+ * \param[in] _policy The growth policy to set the vector to.
+ */
+#define vector_set_policy(_vector, _policy) ({ (_vector)->policy = (_policy); })
+
 // Methods
 
 /**
@@ -180,15 +200,32 @@
  * \param[in] _vector The vector to pop the item from.
  * \param[in] _i The index of the item to pop.
  */
-#define vector_pop(_vector, _i)                                     \
-    ({                                                              \
-        _typeofarray((_vector)->data) _ret = (_vector)->data[(_i)]; \
-        (_vector)->size--;                                          \
-        for (size_t _j = (_i); _j < (_vector)->size; _j++) {        \
-            (_vector)->data[_j] = (_vector)->data[_j + 1];          \
-        }                                                           \
-        _reduce_cap(_vector);                                       \
-        _ret;                                                       \
+#define vector_pop(_vector, _i)                                         \
+    ({                                                                  \
+        const size_t _pop_i = (_i);                                     \
+        _typeofarray((_vector)->data) _ret = (_vector)->data[_pop_i];   \
+        (_vector)->size--;                                              \
+        memmove((_vector)->data + _pop_i, (_vector)->data + _pop_i + 1, \
+                sizeof(*(_vector)->data) * ((_vector)->size - _pop_i)); \
+        _reduce_cap(_vector);                                           \
+        _ret;                                                           \
+    })
+
+/**
+ * \brief     A macro for removing an item from a vector without preserving
+ *            order.
+ * \note      This macro removes the item at the given index by moving the
+ *            last item into its place, which takes constant time.
+ * \param[in] _vector The vector to remove the item from.
+ * \param[in] _i The index of the item to remove.
+ */
+#define vector_swap_remove(_vector, _i)                                \
+    ({                                                                 \
+        const size_t _swap_i = (_i);                                   \
+        _typeofarray((_vector)->data) _ret = (_vector)->data[_swap_i]; \
+        (_vector)->data[_swap_i] = (_vector)->data[--(_vector)->size]; \
+        _reduce_cap(_vector);                                          \
+        _ret;                                                          \
     })
 
 /**
@@ -206,6 +243,131 @@
         vector_pop(_vector, _i);                                   \
     })
 
+/**
+ * \brief     A macro for finding the first position in a sorted vector whose
+ *            item is not less than the given item.
+ * \note      This macro binary searches the vector with the comparison
+ *            function specified when initializing the vector, so the vector
+ *            must be sorted by that function.
+ * \param[in] _vector The sorted vector to search.
+ * \param[in] _item The item to search for.
+ * \return    The index of the first item not less than _item, or the size of
+ *            the vector if there is none.
+ */
+#define vector_lower_bound(_vector, _item)                                          \
+    ({                                                                              \
+        _typeofarray((_vector)->data) _lb_item = (_item);                           \
+        size_t _lb_lo = 0;                                                          \
+        size_t _lb_n = (_vector)->size;                                             \
+        while (_lb_n > 0) {                                                         \
+            const size_t _lb_half = _lb_n / 2;                                      \
+            if ((_vector)->cmp((_vector)->data[_lb_lo + _lb_half], _lb_item) < 0) { \
+                _lb_lo += _lb_half + 1;                                             \
+                _lb_n -= _lb_half + 1;                                              \
+            } else {                                                                \
+                _lb_n = _lb_half;                                                   \
+            }                                                                       \
+        }                                                                           \
+        _lb_lo;                                                                     \
+    })
+
+/**
+ * \brief     A macro for finding the first position in a sorted vector whose
+ *            item is greater than the given item.
+ * \note      This macro binary searches the vector with the comparison
+ *            function specified when initializing the vector, so the vector
+ *            must be sorted by that function.
+ * \param[in] _vector The sorted vector to search.
+ * \param[in] _item The item to search for.
+ * \return    The index of the first item greater than _item, or the size of
+ *            the vector if there is none.
+ */
+#define vector_upper_bound(_vector, _item)                                           \
+    ({                                                                               \
+        _typeofarray((_vector)->data) _ub_item = (_item);                            \
+        size_t _ub_lo = 0;                                                           \
+        size_t _ub_n = (_vector)->size;                                              \
+        while (_ub_n > 0) {                                                          \
+            const size_t _ub_half = _ub_n / 2;                                       \
+            if ((_vector)->cmp((_vector)->data[_ub_lo + _ub_half], _ub_item) <= 0) { \
+                _ub_lo += _ub_half + 1;                                              \
+                _ub_n -= _ub_half + 1;                                               \
+            } else {                                                                 \
+                _ub_n = _ub_half;                                                    \
+            }                                                                        \
+        }                                                                            \
+        _ub_lo;                                                                      \
+    })
+
+/**
+ * \brief     A macro for binary searching a sorted vector.
+ * \note      The vector must be sorted by the comparison function specified
+ *            when initializing the vector.
+ * \param[in] _vector The sorted vector to search.
+ * \param[in] _item The item to search for.
+ * \return    The index of the first item equal to _item, or -1 if the item is
+ *            not in the vector.
+ */
+#define vector_bsearch(_vector, _item)                                                   \
+    ({                                                                                   \
+        _typeofarray((_vector)->data) _bs_item = (_item);                                \
+        const size_t _bs_i = vector_lower_bound(_vector, _bs_item);                      \
+        _bs_i < (_vector)->size && (_vector)->cmp((_vector)->data[_bs_i], _bs_item) == 0 \
+            ? (ssize_t)_bs_i                                                             \
+            : (ssize_t)-1;                                                               \
+    })
+
+/**
+ * \brief     A macro for removing an item from a sorted vector.
+ * \note      This macro finds the item with a binary search instead of the
+ *            linear scan of vector_remove and removes its first occurrence
+ *            while keeping the vector sorted.
+ * \param[in] _vector The sorted vector to remove the item from.
+ * \param[in] _item The item to remove.
+ * \return    true if the item was found and removed, otherwise false.
+ */
+#define vector_remove_sorted(_vector, _item)                  \
+    ({                                                        \
+        const ssize_t _rs_i = vector_bsearch(_vector, _item); \
+        if (_rs_i >= 0)                                       \
+            vector_pop(_vector, _rs_i);                       \
+        _rs_i >= 0;                                           \
+    })
+
+/**
+ * \brief     A macro for keeping only the items of a vector that match a
+ *            predicate.
+ * \note      This macro removes every item the predicate rejects in a single
+ *            linear pass, keeping the order of the remaining items.
+ * \param[in] _vector The vector to filter.
+ * \param[in] _pred The predicate, called with a pointer to each item and
+ *            returning true for items to keep.
+ * \return    The number of items removed.
+ */
+#define vector_retain(_vector, _pred)                                      \
+    ({                                                                     \
+        const size_t _ret_old = (_vector)->size;                           \
+        (_vector)->size = _retain_items((_vector)->data, _ret_old, _pred); \
+        _shrink_cap(_vector);                                              \
+        _ret_old - (_vector)->size;                                        \
+    })
+
+/**
+ * \brief     A macro for removing adjacent duplicate items from a vector.
+ * \note      This macro keeps the first item of every run of adjacent items
+ *            that compare equal with the comparison function of the vector,
+ *            so a sorted vector ends up with unique items.
+ * \param[in] _vector The vector to deduplicate.
+ * \return    The number of items removed.
+ */
+#define vector_dedup(_vector)                                                        \
+    ({                                                                               \
+        const size_t _dedup_old = (_vector)->size;                                   \
+        (_vector)->size = _dedup_items((_vector)->data, _dedup_old, (_vector)->cmp); \
+        _shrink_cap(_vector);                                                        \
+        _dedup_old - (_vector)->size;                                                \
+    })
+
 /**
  * \brief     A macro for getting an item from a vector.
  * \note      This macro gets an item from a vector.
@@ -236,13 +398,132 @@
         (_vector)->size++;                           \
     })
 
+/**
+ * \brief     A macro for emplacing an item at the end of a vector.
+ * \note      This macro grows the vector if needed, adds an uninitialised
+ *            slot at the end and returns a pointer to it, so the item can be
+ *            constructed in place instead of being copied in. The slot must
+ *            be written before the vector is used again.
+ * \param[in] _vector The vector to emplace the item in.
+ * \return    A pointer to the new slot.
+ */
+#define vector_emplace(_vector)              \
+    ({                                       \
+        _ensure_cap(_vector);                \
+        &(_vector)->data[(_vector)->size++]; \
+    })
+
+/**
+ * \brief     A macro for inserting an item into a vector.
+ * \note      This macro inserts an item at the given index, shifting the
+ *            following items up by one.
+ * \param[in] _vector The vector to insert the item into.
+ * \param[in] _item The item to insert into the vector.
+ * \param[in] _i The index to insert the item at.
+ */
+#define vector_insert(_vector, _item, _i)                               \
+    ({                                                                  \
+        const size_t _ins_i = (_i);                                     \
+        _typeofarray((_vector)->data) _ins_item = *(_item);             \
+        _ensure_cap(_vector);                                           \
+        memmove((_vector)->data + _ins_i + 1, (_vector)->data + _ins_i, \
+                sizeof(*(_vector)->data) * ((_vector)->size - _ins_i)); \
+        (_vector)->data[_ins_i] = _ins_item;                            \
+        (_vector)->size++;                                              \
+    })
+
+/**
+ * \brief     A macro for inserting an item into a sorted vector.
+ * \note      This macro inserts the item after any equal items, so the
+ *            vector stays sorted by the comparison function specified when
+ *            initializing the vector and equal items keep their insertion
+ *            order.
+ * \param[in] _vector The sorted vector to insert the item into.
+ * \param[in] _item The item to insert into the vector.
+ * \return    The index the item was inserted at.
+ */
+#define vector_insert_sorted(_vector, _item)                          \
+    ({                                                                \
+        _typeofarray((_vector)->data) _iss_item = *(_item);           \
+        const size_t _iss_i = vector_upper_bound(_vector, _iss_item); \
+        vector_insert(_vector, &_iss_item, _iss_i);                   \
+        _iss_i;                                                       \
+    })
+
+/**
+ * \brief     A macro for reserving capacity in a vector.
+ * \note      This macro ensures the vector can hold at least _n more items
+ *            without growing, reallocating at most once.
+ * \param[in] _vector The vector to reserve capacity in.
+ * \param[in] _n The number of additional items to reserve capacity for.
+ */
+#define vector_reserve(_vector, _n) ({ _reserve_cap(_vector, (_vector)->size + (_n)); })
+
+/**
+ * \brief     A macro for resizing a vector.
+ * \note      This macro sets the size of a vector. When growing, the
+ *            capacity is reserved once and every new slot is set to the
+ *            given item. When shrinking, the items past the new size are
+ *            dropped and the capacity is kept.
+ * \param[in] _vector The vector to resize.
+ * \param[in] _size The new size of the vector.
+ * \param[in] _item The item to fill new slots with.
+ */
+#define vector_resize(_vector, _size, _item)                        \
+    ({                                                              \
+        const size_t _resize_n = (_size);                           \
+        if (_resize_n > (_vector)->size) {                          \
+            _reserve_cap(_vector, _resize_n);                       \
+            for (size_t _j = (_vector)->size; _j < _resize_n; _j++) \
+                (_vector)->data[_j] = *(_item);                     \
+        }                                                           \
+        (_vector)->size = _resize_n;                                \
+    })
+
+/**
+ * \brief     A macro for appending a C-array of items to a vector.
+ * \note      This macro reserves capacity for all the items at once and
+ *            copies them in with a single memcpy.
+ * \param[in] _vector The vector to append the items to.
+ * \param[in] _arr The pointer to the items to append.
+ * \param[in] _n The number of items to append.
+ */
+#define vector_append_array(_vector, _arr, _n)                                                   \
+    ({                                                                                           \
+        const size_t _append_n = (_n);                                                           \
+        _reserve_cap(_vector, (_vector)->size + _append_n);                                      \
+        memcpy((_vector)->data + (_vector)->size, (_arr), sizeof(*(_vector)->data) * _append_n); \
+        (_vector)->size += _append_n;                                                            \
+    })
+
+/**
+ * \brief     A macro for appending all the items of one vector to another.
+ * \note      This macro appends the items of the other vector in order,
+ *            leaving the other vector unchanged.
+ * \param[in] _vector The vector to append the items to.
+ * \param[in] _other The vector to copy the items from.
+ */
+#define vector_extend(_vector, _other) \
+    ({ vector_append_array(_vector, (_other)->data, (_other)->size); })
+
 /**
  * \brief     A macro for sorting a vector.
  * \note      This macro sorts a vector using the comparison function
- *            specified when initializing the vector.
+ *            specified when initializing the vector. Vectors of 32 and 64
+ *            bit integers, float and double are sorted by the SIMD kernel
+ *            first, see sort_dispatch.
+ * \param[in] _vector The vector to sort.
+ */
+#define vector_sort(_vector) ({ sort_dispatch((_vector)->data, (_vector)->size, (_vector)->cmp); })
+
+/**
+ * \brief     A macro for sorting a vector of primitive types in ascending order.
+ * \note      This macro sorts a vector with sort_natural, ignoring the
+ *            comparison function. It should only be used on arithmetic
+ *            types.
  * \param[in] _vector The vector to sort.
  */
-#define vector_sort(_vector) ({ sort((_vector)->data, (_vector)->size, (_vector)->cmp); })
+#define vector_sort_natural(_vector) ({ sort_natural((_vector)->data, (_vector)->size); })
 
 /**
  * \brief     A macro for getting the maximum item in a vector.
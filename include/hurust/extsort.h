@@ -0,0 +1,209 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/*==========================================================================*
+
+  FILE
+    extsort.h
+
+  PROJECT
+    hurust generic library
+
+  DESCRIPTION
+    This file contains the external merge sort, which sorts binary records
+    read from a file descriptor that do not fit in memory. The input is
+    split into memory bounded runs that are sorted and spilled to temporary
+    files, which are then merged back with a heap.
+
+  PROGRAMMER
+    Callum Gran.
+
+  MODIFICATIONS
+    18-Oct-26  C.Gran		Created file.
+
+ *==========================================================================*/
+#ifndef HURUST_EXTSORT_H
+#define HURUST_EXTSORT_H
+
+#include "alloc.h"
+#include "common.h"
+#include "dynamic/dstack.h"
+#include "dynamic/heap.h"
+#include "functional/lambda.h"
+#include "sort.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/**
+ * \brief     Internal function for reading until a buffer is full or the end
+ *            of the file is reached.
+ * \param[in] fd The file descriptor to read from.
+ * \param[out] buf The buffer to read into.
+ * \param[in] len The number of bytes to read.
+ * \return    The number of bytes read, or -1 on error.
+ * \note      This function is internal and should not be used.
+ */
+static inline ssize_t _extsort_read(int fd, void *buf, size_t len)
+{
+    size_t total = 0;
+    while (total < len) {
+        ssize_t n = read(fd, (char *)buf + total, len - total);
+        if (n == 0)
+            break;
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        total += n;
+    }
+    return total;
+}
+
+/**
+ * \brief     Internal function for writing a whole buffer.
+ * \param[in] fd The file descriptor to write to.
+ * \param[in] buf The buffer to write.
+ * \param[in] len The number of bytes to write.
+ * \return    0 on success, or -1 on error.
+ * \note      This function is internal and should not be used.
+ */
+static inline int _extsort_write(int fd, const void *buf, size_t len)
+{
+    size_t total = 0;
+    while (total < len) {
+        ssize_t n = write(fd, (const char *)buf + total, len - total);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        total += n;
+    }
+    return 0;
+}
+
+/**
+ * \brief     A macro for sorting binary records from a file descriptor that
+ *            may not fit in memory.
+ * \note      Records of the given type are read from the input until the end
+ *            of the file. At most run_len records are held in memory at a
+ *            time: each run is sorted with sort and spilled to a temporary
+ *            file, after which the runs are merged into the output with a
+ *            heap holding one record per run. Input that fits in a single
+ *            run is sorted and written directly without temporary files.
+ *            The run buffer is reused as the output buffer while merging,
+ *            so the memory used is the run buffer, the merge heap and the
+ *            stdio buffer of each run.
+ * \param[in] _type The type of the records.
+ * \param[in] _in_fd The file descriptor to read the records from.
+ * \param[in] _out_fd The file descriptor to write the sorted records to.
+ * \param[in] _allocator The allocator used for the buffers.
+ * \param[in] _run_len The maximum number of records held in memory.
+ * \param[in] _cmp The comparison function for the records.
+ * \return    0 on success, or -1 if reading, writing or creating a
+ *            temporary file failed, or if the input ended with a partial
+ *            record.
+ */
+#define external_sort(_type, _in_fd, _out_fd, _allocator, _run_len, _cmp)                      \
+    ({                                                                                         \
+        int _es_ret = 0;                                                                       \
+        const int _es_in = (_in_fd);                                                           \
+        const int _es_out = (_out_fd);                                                         \
+        struct hr_allocator_t *_es_alloc = (_allocator);                                       \
+        size_t _es_len = (_run_len);                                                           \
+        if (_es_len == 0)                                                                      \
+            _es_len = 1;                                                                       \
+        __auto_type _es_cmp = (_cmp);                                                          \
+        _type *_es_buf = HR_ALLOC(_es_alloc, sizeof(_type) * _es_len);                         \
+        DSTACK(FILE *, _es_file);                                                              \
+        struct _es_file_dstack_t _es_runs;                                                     \
+        dstack_init(&_es_runs, _es_alloc, 8);                                                  \
+        while (true) {                                                                         \
+            ssize_t _es_bytes = _extsort_read(_es_in, _es_buf, sizeof(_type) * _es_len);       \
+            if (_es_bytes < 0 || _es_bytes % sizeof(_type) != 0) {                             \
+                _es_ret = -1;                                                                  \
+                break;                                                                         \
+            }                                                                                  \
+            size_t _es_n = _es_bytes / sizeof(_type);                                          \
+            if (_es_n == 0)                                                                    \
+                break;                                                                         \
+            sort(_es_buf, _es_n, _es_cmp);                                                     \
+            if (_es_n < _es_len && dstack_empty(&_es_runs)) {                                  \
+                _es_ret = _extsort_write(_es_out, _es_buf, sizeof(_type) * _es_n);             \
+                break;                                                                         \
+            }                                                                                  \
+            FILE *_es_run = tmpfile();                                                         \
+            if (_es_run == NULL) {                                                             \
+                _es_ret = -1;                                                                  \
+                break;                                                                         \
+            }                                                                                  \
+            dstack_push(&_es_runs, &_es_run);                                                  \
+            if (fwrite(_es_buf, sizeof(_type), _es_n, _es_run) != _es_n ||                     \
+                fflush(_es_run) != 0) {                                                        \
+                _es_ret = -1;                                                                  \
+                break;                                                                         \
+            }                                                                                  \
+            rewind(_es_run);                                                                   \
+            if (_es_n < _es_len)                                                               \
+                break;                                                                         \
+        }                                                                                      \
+        if (_es_ret == 0 && !dstack_empty(&_es_runs)) {                                        \
+            struct _es_node {                                                                  \
+                _type item;                                                                    \
+                size_t run;                                                                    \
+            };                                                                                 \
+            HEAP(struct _es_node, _es_node);                                                   \
+            struct _es_node_heap_t _es_heap;                                                   \
+            heap_init(&_es_heap, _es_alloc, dstack_get_size(&_es_runs) + 1,                    \
+                      lambda(int, (const struct _es_node _a, const struct _es_node _b),        \
+                             { return _es_cmp(_a.item, _b.item); }));                          \
+            for (size_t _es_r = 0; _es_r < dstack_get_size(&_es_runs); _es_r++) {              \
+                struct _es_node _es_node = { .run = _es_r };                                   \
+                if (fread(&_es_node.item, sizeof(_type), 1, _es_runs.data[_es_r]) == 1)        \
+                    heap_push(&_es_heap, &_es_node);                                           \
+            }                                                                                  \
+            size_t _es_out_n = 0;                                                              \
+            while (_es_ret == 0 && !heap_empty(&_es_heap)) {                                   \
+                struct _es_node _es_node = heap_peek(&_es_heap);                               \
+                _es_buf[_es_out_n++] = _es_node.item;                                          \
+                if (_es_out_n == _es_len) {                                                    \
+                    _es_ret = _extsort_write(_es_out, _es_buf, sizeof(_type) * _es_out_n);     \
+                    _es_out_n = 0;                                                             \
+                }                                                                              \
+                if (fread(&_es_node.item, sizeof(_type), 1, _es_runs.data[_es_node.run]) == 1) \
+                    heap_replace(&_es_heap, &_es_node);                                        \
+                else {                                                                         \
+                    heap_pop(&_es_heap);                                                       \
+                    if (ferror(_es_runs.data[_es_node.run]))                                   \
+                        _es_ret = -1;                                                          \
+                }                                                                              \
+            }                                                                                  \
+            if (_es_ret == 0 && _es_out_n > 0)                                                 \
+                _es_ret = _extsort_write(_es_out, _es_buf, sizeof(_type) * _es_out_n);         \
+            heap_free(&_es_heap);                                                              \
+        }                                                                                      \
+        while (!dstack_empty(&_es_runs))                                                       \
+            fclose(dstack_pop(&_es_runs));                                                     \
+        dstack_free(&_es_runs);                                                                \
+        HR_DEALLOC(_es_alloc, _es_buf);                                                        \
+        _es_ret;                                                                               \
+    })
+
+#endif // HURUST_EXTSORT_H
@@ -0,0 +1,690 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/*==========================================================================*
+
+  FILE
+    simd.h
+
+  PROJECT
+    hurust generic library
+
+  DESCRIPTION
+    This file contains SIMD reductions over arrays of primitive types. The
+    kernels are written with GCC vector extensions and are cloned for AVX2
+    and a generic target, so the best version is picked at load time
+    without a function pointer call per element.
+
+  PROGRAMMER
+    Callum Gran.
+
+  MODIFICATIONS
+    18-Oct-26  C.Gran		Created file.
+
+ *==========================================================================*/
+#ifndef HURUST_SIMD_H
+#define HURUST_SIMD_H
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+
+/**
+ * \brief     The width in bytes of the vectors used by the kernels.
+ */
+#define HR_SIMD_WIDTH 32
+
+/**
+ * \brief     The number of vector iterations a count kernel runs before
+ *            flushing its lane counters, so 8-bit lanes never overflow.
+ */
+#define HR_SIMD_COUNT_BLOCK 127
+
+/**
+ * \brief     The attribute used to clone every kernel for each target.
+ * \note      Define this before including the header to change the targets,
+ *            or define it empty to only build for the compile target.
+ */
+#ifndef HR_SIMD_TARGET_CLONES
+#if defined(__x86_64__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define HR_SIMD_TARGET_CLONES __attribute__((target_clones("avx2", "default")))
+#define _HR_SIMD_CLONES_AVX2
+#endif
+#endif
+#endif
+
+#ifndef HR_SIMD_TARGET_CLONES
+#define HR_SIMD_TARGET_CLONES
+#endif
+
+typedef uint64_t _simd_u64_vec_t __attribute__((vector_size(HR_SIMD_WIDTH)));
+
+/**
+ * \brief     Internal macro for loading a vector from unaligned memory.
+ * \param[in] _vec The vector to load into.
+ * \param[in] _ptr The pointer to load from.
+ * \note      This macro is internal and should not be used.
+ */
+#define _simd_load(_vec, _ptr) ({ memcpy(&(_vec), (_ptr), sizeof(_vec)); })
+
+/**
+ * \brief     Internal macro for choosing lanes from two vectors by a mask.
+ * \note      Lanes of _a are chosen where the mask is set and lanes of _b
+ *            elsewhere. The vectors are reinterpreted as the mask type, so
+ *            this also works for floating point vectors.
+ * \param[in] _mask The mask from comparing the vectors.
+ * \param[in] _a The vector to choose set lanes from.
+ * \param[in] _b The vector to choose unset lanes from.
+ * \note      This macro is internal and should not be used.
+ */
+#define _simd_select(_mask, _a, _b) \
+    ((typeof(_a))((((typeof(_mask))(_a)) & (_mask)) | (((typeof(_mask))(_b)) & ~(_mask))))
+
+/**
+ * \brief     Internal macro for checking if any lane of a mask is set.
+ * \param[in] _mask The mask to check.
+ * \note      This macro is internal and should not be used.
+ */
+#define _simd_any(_mask)                                          \
+    ({                                                            \
+        const _simd_u64_vec_t _any_u = (_simd_u64_vec_t)(_mask);  \
+        ((_any_u[0] | _any_u[1]) | (_any_u[2] | _any_u[3])) != 0; \
+    })
+
+/**
+ * \brief     Internal macro for defining the kernels for a primitive type.
+ * \note      This macro defines the vector types and the min, max, sum,
+ *            count and find kernels for the given type. Sums are
+ *            accumulated in sum_type, which is wider than the type for
+ *            integers and single precision floats.
+ * \param[in] type The primitive type of the kernels.
+ * \param[in] name The name used in the kernel function names.
+ * \param[in] sum_type The type the sum kernel accumulates in and returns.
+ * \param[in] mask_type The signed integer type of the same size as type,
+ *            which comparisons of the vectors produce.
+ * \note      This macro is internal and should not be used.
+ */
+#define _SIMD_KERNELS(type, name, sum_type, mask_type)                                       \
+    typedef type _simd_##name##_vec_t __attribute__((vector_size(HR_SIMD_WIDTH)));           \
+    typedef sum_type _simd_##name##_wide_t                                                   \
+        __attribute__((vector_size(HR_SIMD_WIDTH / sizeof(type) * sizeof(sum_type))));       \
+    typedef mask_type _simd_##name##_mask_t __attribute__((vector_size(HR_SIMD_WIDTH)));     \
+                                                                                             \
+    HR_SIMD_TARGET_CLONES __attribute__((unused)) static type _simd_##name##_min(            \
+        const type *arr, size_t n)                                                           \
+    {                                                                                        \
+        const size_t lanes = HR_SIMD_WIDTH / sizeof(type);                                   \
+        type ret = arr[0];                                                                   \
+        size_t i = 0;                                                                        \
+        if (n >= lanes) {                                                                    \
+            _simd_##name##_vec_t acc, v;                                                     \
+            _simd_load(acc, arr);                                                            \
+            for (i = lanes; i + lanes <= n; i += lanes) {                                    \
+                _simd_load(v, arr + i);                                                      \
+                acc = _simd_select(v < acc, v, acc);                                         \
+            }                                                                                \
+            ret = acc[0];                                                                    \
+            for (size_t j = 1; j < lanes; j++)                                               \
+                if (acc[j] < ret)                                                            \
+                    ret = acc[j];                                                            \
+        }                                                                                    \
+        for (; i < n; i++)                                                                   \
+            if (arr[i] < ret)                                                                \
+                ret = arr[i];                                                                \
+        return ret;                                                                          \
+    }                                                                                        \
+                                                                                             \
+    HR_SIMD_TARGET_CLONES __attribute__((unused)) static type _simd_##name##_max(            \
+        const type *arr, size_t n)                                                           \
+    {                                                                                        \
+        const size_t lanes = HR_SIMD_WIDTH / sizeof(type);                                   \
+        type ret = arr[0];                                                                   \
+        size_t i = 0;                                                                        \
+        if (n >= lanes) {                                                                    \
+            _simd_##name##_vec_t acc, v;                                                     \
+            _simd_load(acc, arr);                                                            \
+            for (i = lanes; i + lanes <= n; i += lanes) {                                    \
+                _simd_load(v, arr + i);                                                      \
+                acc = _simd_select(v > acc, v, acc);                                         \
+            }                                                                                \
+            ret = acc[0];                                                                    \
+            for (size_t j = 1; j < lanes; j++)                                               \
+                if (acc[j] > ret)                                                            \
+                    ret = acc[j];                                                            \
+        }                                                                                    \
+        for (; i < n; i++)                                                                   \
+            if (arr[i] > ret)                                                                \
+                ret = arr[i];                                                                \
+        return ret;                                                                          \
+    }                                                                                        \
+                                                                                             \
+    HR_SIMD_TARGET_CLONES __attribute__((unused)) static sum_type _simd_##name##_sum(        \
+        const type *arr, size_t n)                                                           \
+    {                                                                                        \
+        const size_t lanes = HR_SIMD_WIDTH / sizeof(type);                                   \
+        _simd_##name##_wide_t acc0 = {}, acc1 = {}, acc2 = {}, acc3 = {};                    \
+        _simd_##name##_vec_t v0, v1, v2, v3;                                                 \
+        size_t i = 0;                                                                        \
+        for (; i + 4 * lanes <= n; i += 4 * lanes) {                                         \
+            _simd_load(v0, arr + i);                                                         \
+            _simd_load(v1, arr + i + lanes);                                                 \
+            _simd_load(v2, arr + i + 2 * lanes);                                             \
+            _simd_load(v3, arr + i + 3 * lanes);                                             \
+            acc0 += __builtin_convertvector(v0, _simd_##name##_wide_t);                      \
+            acc1 += __builtin_convertvector(v1, _simd_##name##_wide_t);                      \
+            acc2 += __builtin_convertvector(v2, _simd_##name##_wide_t);                      \
+            acc3 += __builtin_convertvector(v3, _simd_##name##_wide_t);                      \
+        }                                                                                    \
+        for (; i + lanes <= n; i += lanes) {                                                 \
+            _simd_load(v0, arr + i);                                                         \
+            acc0 += __builtin_convertvector(v0, _simd_##name##_wide_t);                      \
+        }                                                                                    \
+        acc0 = (acc0 + acc1) + (acc2 + acc3);                                                \
+        sum_type ret = 0;                                                                    \
+        for (size_t j = 0; j < lanes; j++)                                                   \
+            ret += acc0[j];                                                                  \
+        for (; i < n; i++)                                                                   \
+            ret += arr[i];                                                                   \
+        return ret;                                                                          \
+    }                                                                                        \
+                                                                                             \
+    HR_SIMD_TARGET_CLONES __attribute__((unused)) static size_t _simd_##name##_count(        \
+        const type *arr, size_t n, type value)                                               \
+    {                                                                                        \
+        const size_t lanes = HR_SIMD_WIDTH / sizeof(type);                                   \
+        _simd_##name##_vec_t v;                                                              \
+        size_t ret = 0;                                                                      \
+        size_t i = 0;                                                                        \
+        while (i + lanes <= n) {                                                             \
+            _simd_##name##_mask_t cnt = {};                                                  \
+            for (size_t b = 0; b < HR_SIMD_COUNT_BLOCK && i + lanes <= n; b++, i += lanes) { \
+                _simd_load(v, arr + i);                                                      \
+                cnt -= v == value;                                                           \
+            }                                                                                \
+            for (size_t j = 0; j < lanes; j++)                                               \
+                ret += cnt[j];                                                               \
+        }                                                                                    \
+        for (; i < n; i++)                                                                   \
+            ret += arr[i] == value;                                                          \
+        return ret;                                                                          \
+    }                                                                                        \
+                                                                                             \
+    HR_SIMD_TARGET_CLONES __attribute__((unused)) static ssize_t _simd_##name##_find(        \
+        const type *arr, size_t n, type value)                                               \
+    {                                                                                        \
+        const size_t lanes = HR_SIMD_WIDTH / sizeof(type);                                   \
+        _simd_##name##_vec_t v;                                                              \
+        size_t i = 0;                                                                        \
+        for (; i + lanes <= n; i += lanes) {                                                 \
+            _simd_load(v, arr + i);                                                          \
+            if (_simd_any(v == value))                                                       \
+                break;                                                                       \
+        }                                                                                    \
+        for (; i < n; i++)                                                                   \
+            if (arr[i] == value)                                                             \
+                return i;                                                                    \
+        return -1;                                                                           \
+    }
+
+_SIMD_KERNELS(int8_t, i8, int64_t, int8_t)
+_SIMD_KERNELS(uint8_t, u8, uint64_t, int8_t)
+_SIMD_KERNELS(int16_t, i16, int64_t, int16_t)
+_SIMD_KERNELS(uint16_t, u16, uint64_t, int16_t)
+_SIMD_KERNELS(int32_t, i32, int64_t, int32_t)
+_SIMD_KERNELS(uint32_t, u32, uint64_t, int32_t)
+_SIMD_KERNELS(int64_t, i64, int64_t, int64_t)
+_SIMD_KERNELS(uint64_t, u64, uint64_t, int64_t)
+_SIMD_KERNELS(float, f32, double, int32_t)
+_SIMD_KERNELS(double, f64, double, int64_t)
+
+/* char is its own type apart from int8_t and uint8_t, and long long is not
+ * int64_t where long is 64 bits wide, so they get kernels of their own. */
+#if CHAR_MIN < 0
+_SIMD_KERNELS(char, char, int64_t, int8_t)
+#else
+_SIMD_KERNELS(char, char, uint64_t, int8_t)
+#endif
+_SIMD_KERNELS(long long, ll, long long, long long)
+_SIMD_KERNELS(unsigned long long, ull, unsigned long long, long long)
+
+/**
+ * \brief     Internal macro for checking if the running code has a fast
+ *            shuffle by a variable mask.
+ * \note      Only AVX2 shuffles 32 and 64 bit lanes by a variable mask in
+ *            one instruction. Elsewhere the shuffle is split into moves of
+ *            single lanes, which is slower than storing the lanes one by
+ *            one. Under the default clones only the AVX2 clone runs on a
+ *            CPU with AVX2, so checking the CPU tells the clones apart.
+ * \note      This macro is internal and should not be used.
+ */
+#if defined(__AVX2__)
+#define _simd_fast_shuffle() true
+#elif defined(_HR_SIMD_CLONES_AVX2)
+#define _simd_fast_shuffle() __builtin_cpu_supports("avx2")
+#else
+#define _simd_fast_shuffle() false
+#endif
+
+/**
+ * \brief     The number of items at or below which the sort kernels finish
+ *            a range with insertion sort instead of partitioning it.
+ * \note      The partition needs at least two vectors of items, so this
+ *            must be at least twice the number of lanes of a vector.
+ */
+#define HR_SIMD_SORT_THRESHOLD 32
+
+/**
+ * \brief     Internal table for packing the lanes of an 8 lane vector.
+ * \note      Row m holds, 3 bits per lane, the lanes whose bit is set in m
+ *            followed by the lanes whose bit is clear, both in order. A
+ *            shuffle by the row moves the items matching a mask to the
+ *            front and the rest to the back.
+ * \note      This table is internal and should not be used.
+ */
+__attribute__((unused)) static const uint32_t _simd_compress8_lut[256] = {
+    0xfac688, 0xfac688, 0xfac681, 0xfac688, 0xfac642, 0xfac650, 0xfac611, 0xfac688,
+    0xfac443, 0xfac458, 0xfac419, 0xfac4c8, 0xfac21a, 0xfac2d0, 0xfac0d1, 0xfac688,
+    0xfab444, 0xfab460, 0xfab421, 0xfab508, 0xfab222, 0xfab310, 0xfab111, 0xfab888,
+    0xfaa223, 0xfaa318, 0xfaa119, 0xfaa8c8, 0xfa911a, 0xfa98d0, 0xfa88d1, 0xfac688,
+    0xfa3445, 0xfa3468, 0xfa3429, 0xfa3548, 0xfa322a, 0xfa3350, 0xfa3151, 0xfa3a88,
+    0xfa222b, 0xfa2358, 0xfa2159, 0xfa2ac8, 0xfa115a, 0xfa1ad0, 0xfa0ad1, 0xfa5688,
+    0xf9a22c, 0xf9a360, 0xf9a161, 0xf9ab08, 0xf99162, 0xf99b10, 0xf98b11, 0xf9d888,
+    0xf91163, 0xf91b18, 0xf90b19, 0xf958c8, 0xf88b1a, 0xf8d8d0, 0xf858d1, 0xfac688,
+    0xf63446, 0xf63470, 0xf63431, 0xf63588, 0xf63232, 0xf63390, 0xf63191, 0xf63c88,
+    0xf62233, 0xf62398, 0xf62199, 0xf62cc8, 0xf6119a, 0xf61cd0, 0xf60cd1, 0xf66688,
+    0xf5a234, 0xf5a3a0, 0xf5a1a1, 0xf5ad08, 0xf591a2, 0xf59d10, 0xf58d11, 0xf5e888,
+    0xf511a3, 0xf51d18, 0xf50d19, 0xf568c8, 0xf48d1a, 0xf4e8d0, 0xf468d1, 0xf74688,
+    0xf1a235, 0xf1a3a8, 0xf1a1a9, 0xf1ad48, 0xf191aa, 0xf19d50, 0xf18d51, 0xf1ea88,
+    0xf111ab, 0xf11d58, 0xf10d59, 0xf16ac8, 0xf08d5a, 0xf0ead0, 0xf06ad1, 0xf35688,
+    0xed11ac, 0xed1d60, 0xed0d61, 0xed6b08, 0xec8d62, 0xeceb10, 0xec6b11, 0xef5888,
+    0xe88d63, 0xe8eb18, 0xe86b19, 0xeb58c8, 0xe46b1a, 0xe758d0, 0xe358d1, 0xfac688,
+    0xd63447, 0xd63478, 0xd63439, 0xd635c8, 0xd6323a, 0xd633d0, 0xd631d1, 0xd63e88,
+    0xd6223b, 0xd623d8, 0xd621d9, 0xd62ec8, 0xd611da, 0xd61ed0, 0xd60ed1, 0xd67688,
+    0xd5a23c, 0xd5a3e0, 0xd5a1e1, 0xd5af08, 0xd591e2, 0xd59f10, 0xd58f11, 0xd5f888,
+    0xd511e3, 0xd51f18, 0xd50f19, 0xd578c8, 0xd48f1a, 0xd4f8d0, 0xd478d1, 0xd7c688,
+    0xd1a23d, 0xd1a3e8, 0xd1a1e9, 0xd1af48, 0xd191ea, 0xd19f50, 0xd18f51, 0xd1fa88,
+    0xd111eb, 0xd11f58, 0xd10f59, 0xd17ac8, 0xd08f5a, 0xd0fad0, 0xd07ad1, 0xd3d688,
+    0xcd11ec, 0xcd1f60, 0xcd0f61, 0xcd7b08, 0xcc8f62, 0xccfb10, 0xcc7b11, 0xcfd888,
+    0xc88f63, 0xc8fb18, 0xc87b19, 0xcbd8c8, 0xc47b1a, 0xc7d8d0, 0xc3d8d1, 0xdec688,
+    0xb1a23e, 0xb1a3f0, 0xb1a1f1, 0xb1af88, 0xb191f2, 0xb19f90, 0xb18f91, 0xb1fc88,
+    0xb111f3, 0xb11f98, 0xb10f99, 0xb17cc8, 0xb08f9a, 0xb0fcd0, 0xb07cd1, 0xb3e688,
+    0xad11f4, 0xad1fa0, 0xad0fa1, 0xad7d08, 0xac8fa2, 0xacfd10, 0xac7d11, 0xafe888,
+    0xa88fa3, 0xa8fd18, 0xa87d19, 0xabe8c8, 0xa47d1a, 0xa7e8d0, 0xa3e8d1, 0xbf4688,
+    0x8d11f5, 0x8d1fa8, 0x8d0fa9, 0x8d7d48, 0x8c8faa, 0x8cfd50, 0x8c7d51, 0x8fea88,
+    0x888fab, 0x88fd58, 0x887d59, 0x8beac8, 0x847d5a, 0x87ead0, 0x83ead1, 0x9f5688,
+    0x688fac, 0x68fd60, 0x687d61, 0x6beb08, 0x647d62, 0x67eb10, 0x63eb11, 0x7f5888,
+    0x447d63, 0x47eb18, 0x43eb19, 0x5f58c8, 0x23eb1a, 0x3f58d0, 0x1f58d1, 0xfac688
+};
+
+/**
+ * \brief     Internal table for packing the lanes of a 4 lane vector.
+ * \note      Row m holds, 2 bits per lane, the lanes whose bit is set in m
+ *            followed by the lanes whose bit is clear, both in order.
+ * \note      This table is internal and should not be used.
+ */
+__attribute__((unused)) static const uint8_t _simd_compress4_lut[16] = {
+    0xe4, 0xe4, 0xe1, 0xe4, 0xd2, 0xd8, 0xc9, 0xe4,
+    0x93, 0x9c, 0x8d, 0xb4, 0x4e, 0x78, 0x39, 0xe4
+};
+
+/**
+ * \brief     Internal macro for defining the sort kernel for a primitive
+ *            type.
+ * \note      This macro defines a quicksort that partitions a vector of
+ *            items at a time. The items of a vector are compared with the
+ *            pivot, packed by the mask with a shuffle from the tables above
+ *            and stored to both ends of the range. Two vectors are read
+ *            ahead of the writes so no unread item is overwritten. It needs
+ *            the vector types defined by _SIMD_KERNELS for the type.
+ * \param[in] type The primitive type of the kernel, 4 or 8 bytes wide.
+ * \param[in] name The name used in the kernel function names.
+ * \note      This macro is internal and should not be used.
+ */
+#define _SIMD_SORT_KERNELS(type, name)                                                       \
+    static inline __attribute__((always_inline)) size_t _simd_##name##_partition(            \
+        type *arr, size_t n, type pivot, bool le, bool shuffle)                              \
+    {                                                                                        \
+        const size_t lanes = HR_SIMD_WIDTH / sizeof(type);                                   \
+        _simd_##name##_mask_t iota;                                                          \
+        for (size_t j = 0; j < lanes; j++)                                                   \
+            iota[j] = j;                                                                     \
+        const _simd_##name##_mask_t bit = ((_simd_##name##_mask_t){} + 1) << iota;           \
+        const _simd_##name##_mask_t shift = iota * (lanes == 8 ? 3 : 2);                     \
+        const _simd_##name##_vec_t pv = (_simd_##name##_vec_t){} + pivot;                    \
+        _simd_##name##_vec_t first, last, v;                                                 \
+        _simd_load(first, arr);                                                              \
+        _simd_load(last, arr + n - lanes);                                                   \
+        size_t l = lanes, r = n - lanes, wl = 0, wr = n;                                     \
+        while (r - l >= lanes) {                                                             \
+            if (l - wl <= wr - r) {                                                          \
+                _simd_load(v, arr + l);                                                      \
+                l += lanes;                                                                  \
+            } else {                                                                         \
+                r -= lanes;                                                                  \
+                _simd_load(v, arr + r);                                                      \
+            }                                                                                \
+            const _simd_##name##_mask_t m = le ? ~(pv < v) : v < pv;                         \
+            if (!shuffle) {                                                                  \
+                for (size_t j = 0; j < lanes; j++) {                                         \
+                    arr[wl] = v[j];                                                          \
+                    arr[wr - 1] = v[j];                                                      \
+                    wl -= m[j];                                                              \
+                    wr -= 1 + m[j];                                                          \
+                }                                                                            \
+                continue;                                                                    \
+            }                                                                                \
+            const _simd_##name##_mask_t mb = m & bit;                                        \
+            unsigned bits = 0;                                                               \
+            for (size_t j = 0; j < lanes; j++)                                               \
+                bits |= mb[j];                                                               \
+            const unsigned cnt = __builtin_popcount(bits);                                   \
+            const typeof(iota[0]) row =                                                      \
+                lanes == 8 ? _simd_compress8_lut[bits] : _simd_compress4_lut[bits];          \
+            const _simd_##name##_mask_t idx =                                                \
+                (((_simd_##name##_mask_t){} + row) >> shift) & (typeof(iota[0]))(lanes - 1); \
+            const _simd_##name##_vec_t packed = __builtin_shuffle(v, idx);                   \
+            memcpy(arr + wl, &packed, sizeof(packed));                                       \
+            memcpy(arr + wr - lanes, &packed, sizeof(packed));                               \
+            wl += cnt;                                                                       \
+            wr -= lanes - cnt;                                                               \
+        }                                                                                    \
+        type rest[3 * HR_SIMD_WIDTH / sizeof(type)];                                         \
+        memcpy(rest, &first, sizeof(first));                                                 \
+        memcpy(rest + lanes, &last, sizeof(last));                                           \
+        memcpy(rest + 2 * lanes, arr + l, sizeof(type) * (r - l));                           \
+        for (size_t j = 0; j < 2 * lanes + r - l; j++) {                                     \
+            const bool left = le ? !(pivot < rest[j]) : rest[j] < pivot;                     \
+            arr[wl] = rest[j];                                                               \
+            arr[wr - 1] = rest[j];                                                           \
+            wl += left;                                                                      \
+            wr -= !left;                                                                     \
+        }                                                                                    \
+        return wl;                                                                           \
+    }                                                                                        \
+                                                                                             \
+    HR_SIMD_TARGET_CLONES __attribute__((unused)) static void _simd_##name##_sort(type *arr, \
+                                                                                  size_t n)  \
+    {                                                                                        \
+        struct {                                                                             \
+            type *arr;                                                                       \
+            size_t n;                                                                        \
+        } stack[sizeof(size_t) * 8];                                                         \
+        const bool shuffle = _simd_fast_shuffle();                                           \
+        size_t top = 0;                                                                      \
+        while (true) {                                                                       \
+            while (n > HR_SIMD_SORT_THRESHOLD) {                                             \
+                const type a = arr[n / 4], b = arr[n / 2], c = arr[n - n / 4];               \
+                const type pivot = a < b ? (b < c ? b : a < c ? c : a)                       \
+                                         : (a < c ? a : b < c ? c : b);                      \
+                size_t k = _simd_##name##_partition(arr, n, pivot, false, shuffle);          \
+                if (k == 0) {                                                                \
+                    /* Nothing is below the pivot, so the items equal to it                  \
+                       go first and are already where they belong. */                        \
+                    k = _simd_##name##_partition(arr, n, pivot, true, shuffle);              \
+                    arr += k;                                                                \
+                    n -= k;                                                                  \
+                } else if (k < n - k) {                                                      \
+                    stack[top].arr = arr + k;                                                \
+                    stack[top++].n = n - k;                                                  \
+                    n = k;                                                                   \
+                } else {                                                                     \
+                    stack[top].arr = arr;                                                    \
+                    stack[top++].n = k;                                                      \
+                    arr += k;                                                                \
+                    n -= k;                                                                  \
+                }                                                                            \
+            }                                                                                \
+            for (size_t i = 1; i < n; i++) {                                                 \
+                const type x = arr[i];                                                       \
+                size_t j = i;                                                                \
+                for (; j > 0 && x < arr[j - 1]; j--)                                         \
+                    arr[j] = arr[j - 1];                                                     \
+                arr[j] = x;                                                                  \
+            }                                                                                \
+            if (top == 0)                                                                    \
+                return;                                                                      \
+            top--;                                                                           \
+            arr = stack[top].arr;                                                            \
+            n = stack[top].n;                                                                \
+        }                                                                                    \
+    }
+
+_SIMD_SORT_KERNELS(int32_t, i32)
+_SIMD_SORT_KERNELS(uint32_t, u32)
+_SIMD_SORT_KERNELS(int64_t, i64)
+_SIMD_SORT_KERNELS(uint64_t, u64)
+_SIMD_SORT_KERNELS(float, f32)
+_SIMD_SORT_KERNELS(double, f64)
+_SIMD_SORT_KERNELS(long long, ll)
+_SIMD_SORT_KERNELS(unsigned long long, ull)
+
+/**
+ * \brief     Internal function chosen for arrays of types without kernels.
+ * \note      It is never defined, so choosing it fails to compile.
+ * \note      This function is internal and should not be used.
+ */
+void _simd_unsupported_type(void);
+
+/**
+ * \brief     Internal macro for choosing the kernel for the type of an
+ *            array.
+ * \param[in] _arr The array to choose the kernel for.
+ * \note      char, long long and unsigned long long are matched in a nested
+ *            selection, as long long is the same type as int64_t on some
+ *            targets and may not be listed twice.
+ * \param[in] _op The operation to choose the kernel of.
+ * \note      This macro is internal and should not be used.
+ */
+#define _simd_dispatch(_arr, _op)                                           \
+    _Generic((_arr),                                                        \
+        int8_t *: _simd_i8_##_op, const int8_t *: _simd_i8_##_op,           \
+        uint8_t *: _simd_u8_##_op, const uint8_t *: _simd_u8_##_op,         \
+        int16_t *: _simd_i16_##_op, const int16_t *: _simd_i16_##_op,       \
+        uint16_t *: _simd_u16_##_op, const uint16_t *: _simd_u16_##_op,     \
+        int32_t *: _simd_i32_##_op, const int32_t *: _simd_i32_##_op,       \
+        uint32_t *: _simd_u32_##_op, const uint32_t *: _simd_u32_##_op,     \
+        int64_t *: _simd_i64_##_op, const int64_t *: _simd_i64_##_op,       \
+        uint64_t *: _simd_u64_##_op, const uint64_t *: _simd_u64_##_op,     \
+        float *: _simd_f32_##_op, const float *: _simd_f32_##_op,           \
+        double *: _simd_f64_##_op, const double *: _simd_f64_##_op,         \
+        default: _Generic((_arr),                                           \
+            char *: _simd_char_##_op, const char *: _simd_char_##_op,       \
+            long long *: _simd_ll_##_op, const long long *: _simd_ll_##_op, \
+            unsigned long long *: _simd_ull_##_op,                          \
+            const unsigned long long *: _simd_ull_##_op,                    \
+            default: _simd_unsupported_type))
+
+/**
+ * \brief     A macro for getting the minimum item in an array of primitive
+ *            types.
+ * \note      The array must not be empty. Floating point arrays containing
+ *            NaN give an unspecified result.
+ * \param[in] _arr The array to get the minimum item from.
+ * \param[in] _n The number of items in the array.
+ */
+#define simd_min(_arr, _n) (_simd_dispatch(_arr, min)((_arr), (_n)))
+
+/**
+ * \brief     A macro for getting the maximum item in an array of primitive
+ *            types.
+ * \note      The array must not be empty. Floating point arrays containing
+ *            NaN give an unspecified result.
+ * \param[in] _arr The array to get the maximum item from.
+ * \param[in] _n The number of items in the array.
+ */
+#define simd_max(_arr, _n) (_simd_dispatch(_arr, max)((_arr), (_n)))
+
+/**
+ * \brief     A macro for summing an array of primitive types.
+ * \note      Integers are summed as int64_t or uint64_t and floats as
+ *            double. Floating point sums are added in a different order
+ *            than a plain loop, so the result may differ in the last bits.
+ * \param[in] _arr The array to sum.
+ * \param[in] _n The number of items in the array.
+ */
+#define simd_sum(_arr, _n) (_simd_dispatch(_arr, sum)((_arr), (_n)))
+
+/**
+ * \brief     A macro for counting the items in an array of primitive types
+ *            that are equal to a value.
+ * \param[in] _arr The array to count in.
+ * \param[in] _n The number of items in the array.
+ * \param[in] _value The value to count.
+ */
+#define simd_count(_arr, _n, _value) (_simd_dispatch(_arr, count)((_arr), (_n), (_value)))
+
+/**
+ * \brief     A macro for finding the first item in an array of primitive
+ *            types that is equal to a value.
+ * \param[in] _arr The array to search.
+ * \param[in] _n The number of items in the array.
+ * \param[in] _value The value to search for.
+ * \return    The index of the first equal item, or -1 if there is none.
+ */
+#define simd_find(_arr, _n, _value) (_simd_dispatch(_arr, find)((_arr), (_n), (_value)))
+
+/**
+ * \brief     Internal function chosen by sort_natural and sort_dispatch for
+ *            arrays of types without a sort kernel.
+ * \note      It is never called, as those macros check
+ *            _simd_sort_supported first and use sort instead.
+ * \note      This function is internal and should not be used.
+ */
+__attribute__((unused)) static inline void _simd_sort_none(void *arr, size_t n)
+{
+    (void)arr;
+    (void)n;
+}
+
+/**
+ * \brief     Internal macro for choosing the sort kernel for the type of an
+ *            array.
+ * \param[in] _arr The array to choose the kernel for.
+ * \param[in] _fallback The function chosen for types without a kernel.
+ * \note      This macro is internal and should not be used.
+ */
+#define _simd_sort_dispatch(_arr, _fallback)                                  \
+    _Generic((_arr),                                                          \
+        int32_t *: _simd_i32_sort, uint32_t *: _simd_u32_sort,                \
+        int64_t *: _simd_i64_sort, uint64_t *: _simd_u64_sort,                \
+        float *: _simd_f32_sort, double *: _simd_f64_sort,                    \
+        default: _Generic((_arr),                                             \
+            long long *: _simd_ll_sort, unsigned long long *: _simd_ull_sort, \
+            default: _fallback))
+
+/**
+ * \brief     Internal macro for checking if there is a sort kernel for the
+ *            type of an array.
+ * \param[in] _arr The array to check.
+ * \return    A constant true or false.
+ * \note      This macro is internal and should not be used.
+ */
+#define _simd_sort_supported(_arr)                                            \
+    _Generic((_arr),                                                          \
+        int32_t *: true, uint32_t *: true, int64_t *: true, uint64_t *: true, \
+        float *: true, double *: true,                                        \
+        default: _Generic((_arr), long long *: true, unsigned long long *: true, default: false))
+
+/**
+ * \brief     A macro for sorting an array of primitive types in ascending
+ *            order.
+ * \note      There are kernels for 32 and 64 bit integers, float and double.
+ *            Items that compare equal may be reordered. Floating point
+ *            arrays containing NaN are left in an unspecified order.
+ * \param[in] _arr The array to sort.
+ * \param[in] _n The number of items in the array.
+ */
+#define simd_sort(_arr, _n) (_simd_sort_dispatch(_arr, _simd_unsupported_type)((_arr), (_n)))
+
+// Collection wrappers
+
+/**
+ * \brief     A macro for getting the minimum item in a vector of primitive
+ *            types without calling its comparison function.
+ * \param[in] _vector The vector to get the minimum item from.
+ */
+#define vector_simd_min(_vector) simd_min((_vector)->data, (_vector)->size)
+
+/**
+ * \brief     A macro for getting the maximum item in a vector of primitive
+ *            types without calling its comparison function.
+ * \param[in] _vector The vector to get the maximum item from.
+ */
+#define vector_simd_max(_vector) simd_max((_vector)->data, (_vector)->size)
+
+/**
+ * \brief     A macro for summing a vector of primitive types.
+ * \param[in] _vector The vector to sum.
+ */
+#define vector_simd_sum(_vector) simd_sum((_vector)->data, (_vector)->size)
+
+/**
+ * \brief     A macro for counting the items in a vector of primitive types
+ *            that are equal to a value.
+ * \param[in] _vector The vector to count in.
+ * \param[in] _value The value to count.
+ */
+#define vector_simd_count(_vector, _value) simd_count((_vector)->data, (_vector)->size, _value)
+
+/**
+ * \brief     A macro for finding the first item in a vector of primitive
+ *            types that is equal to a value.
+ * \param[in] _vector The vector to search.
+ * \param[in] _value The value to search for.
+ */
+#define vector_simd_find(_vector, _value) simd_find((_vector)->data, (_vector)->size, _value)
+
+/**
+ * \brief     A macro for getting the minimum item in an array of primitive
+ *            types without calling its comparison function.
+ * \param[in] _array The array to get the minimum item from.
+ */
+#define array_simd_min(_array) simd_min((_array)->data, (_array)->size)
+
+/**
+ * \brief     A macro for getting the maximum item in an array of primitive
+ *            types without calling its comparison function.
+ * \param[in] _array The array to get the maximum item from.
+ */
+#define array_simd_max(_array) simd_max((_array)->data, (_array)->size)
+
+/**
+ * \brief     A macro for summing an array of primitive types.
+ * \param[in] _array The array to sum.
+ */
+#define array_simd_sum(_array) simd_sum((_array)->data, (_array)->size)
+
+/**
+ * \brief     A macro for counting the items in an array of primitive types
+ *            that are equal to a value.
+ * \param[in] _array The array to count in.
+ * \param[in] _value The value to count.
+ */
+#define array_simd_count(_array, _value) simd_count((_array)->data, (_array)->size, _value)
+
+/**
+ * \brief     A macro for finding the first item in an array of primitive
+ *            types that is equal to a value.
+ * \param[in] _array The array to search.
+ * \param[in] _value The value to search for.
+ */
+#define array_simd_find(_array, _value) simd_find((_array)->data, (_array)->size, _value)
+
+#endif // HURUST_SIMD_H
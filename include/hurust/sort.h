@@ -37,17 +37,33 @@
 #ifndef HURUST_SORT_H
 #define HURUST_SORT_H
 
+#include "alloc.h"
+#include "common.h"
+#include "functional/lambda.h"
+#include "simd.h"
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #define INSERTION_SORT_THRESHOLD 27
 
+/**
+ * \brief     Internal comparison used for sorting primitive types in their
+ *            natural order.
+ * \note      Expands to a branchless three-way comparison, so no function
+ *            pointer is called and the compiler is free to inline and
+ *            vectorise the comparisons.
+ * \param[in] a The first item.
+ * \param[in] b The second item.
+ */
+#define _sort_natural_cmp(a, b) (((a) > (b)) - ((a) < (b)))
+
 #define _median_three(left, right, cmp)                       \
     ({                                                        \
         _type *_med_mid = (left) + (((right) - (left)) >> 1); \
-        if ((cmp)(*_med_mid, *(left)) < 0) {                  \
-            if ((cmp)(*(right), *(left)) < 0) {               \
-                if ((cmp)(*(right), *_med_mid) < 0) {         \
+        if (cmp(*_med_mid, *(left)) < 0) {                    \
+            if (cmp(*(right), *(left)) < 0) {                 \
+                if (cmp(*(right), *_med_mid) < 0) {           \
                     swap(_type, (left), (right));             \
                 } else {                                      \
                     rotate(_type, (left), _med_mid, (right)); \
@@ -56,8 +72,8 @@
                 swap(_type, (left), _med_mid);                \
             }                                                 \
         } else {                                              \
-            if ((cmp)(*(right), *_med_mid) < 0) {             \
-                if ((cmp)(*(right), *(left)) < 0) {           \
+            if (cmp(*(right), *_med_mid) < 0) {               \
+                if (cmp(*(right), *(left)) < 0) {             \
                     rotate(_type, (right), _med_mid, (left)); \
                 } else {                                      \
                     swap(_type, _med_mid, (right));           \
@@ -79,10 +95,10 @@
         do {                                                 \
             do                                               \
                 _l++;                                        \
-            while ((cmp)(*_l, _piv) < 0);                    \
+            while (cmp(*_l, _piv) < 0);                      \
             do                                               \
                 _r--;                                        \
-            while ((cmp)(_piv, *_r) < 0);                    \
+            while (cmp(_piv, *_r) < 0);                      \
             if (_l >= _r)                                    \
                 break;                                       \
             swap(_type, _l, _r);                             \
@@ -137,5 +153,203 @@
         } while (_top > _stack);                                  \
     })
 
+/**
+ * \brief     A macro for sorting an array of primitive types in ascending
+ *            order.
+ * \note      Arrays of 32 and 64 bit integers, float and double are sorted
+ *            with the SIMD kernel from simd.h. Other arithmetic types are
+ *            sorted with the same quicksort as sort, comparing items with
+ *            the < and > operators instead of a comparison function.
+ *            Floating point arrays must not contain NaN.
+ * \param[in] arr The array to sort.
+ * \param[in] size The size of the array.
+ */
+#define sort_natural(arr, size)                                       \
+    ({                                                                \
+        if (_simd_sort_supported(arr))                                \
+            _simd_sort_dispatch(arr, _simd_sort_none)((arr), (size)); \
+        else                                                          \
+            sort((arr), (size), _sort_natural_cmp);                   \
+    })
+
+/**
+ * \brief     A macro for sorting an array with a comparison function,
+ *            using the SIMD kernel when there is one for the item type.
+ * \note      Arrays of 32 and 64 bit integers, float and double are first
+ *            sorted in ascending order by the SIMD kernel from simd.h. The
+ *            result is then checked against the comparison function with
+ *            size - 1 calls, and sorted again with sort if the comparison
+ *            function orders the items differently, so the result is always
+ *            sorted by the comparison function. Arrays of other types are
+ *            sorted with sort directly.
+ * \param[in] arr The array to sort.
+ * \param[in] size The size of the array.
+ * \param[in] cmp The comparison function for the items.
+ */
+#define sort_dispatch(arr, size, cmp)                                         \
+    ({                                                                        \
+        _typeofarray((arr)) *_sd_arr = (arr);                                 \
+        const size_t _sd_size = (size);                                       \
+        bool _sd_sorted = false;                                              \
+        if (_simd_sort_supported(_sd_arr)) {                                  \
+            _simd_sort_dispatch(_sd_arr, _simd_sort_none)(_sd_arr, _sd_size); \
+            _sd_sorted = true;                                                \
+            for (size_t _sd_i = 1; _sd_sorted && _sd_i < _sd_size; _sd_i++)   \
+                _sd_sorted = cmp(_sd_arr[_sd_i - 1], _sd_arr[_sd_i]) <= 0;    \
+        }                                                                     \
+        if (!_sd_sorted)                                                      \
+            sort(_sd_arr, _sd_size, cmp);                                     \
+    })
+
+/**
+ * \brief     Internal comparison for the (key, index) pairs used by
+ *            sort_by_key.
+ * \note      Ties on the key are broken by the original index, which makes
+ *            the key based sorts stable.
+ * \param[in] a The first pair.
+ * \param[in] b The second pair.
+ */
+#define _sort_key_pair_cmp(a, b) \
+    (_sort_natural_cmp((a).key, (b).key) ?: _sort_natural_cmp((a).idx, (b).idx))
+
+/**
+ * \brief     Internal macro for sorting an array by a cached key.
+ * \note      This macro computes the key of every item once, sorts the
+ *            (key, index) pairs with the given pair comparison and then
+ *            moves the items into their sorted positions.
+ * \param[in] arr The array to sort.
+ * \param[in] size The size of the array.
+ * \param[in] key_fn The function extracting the key from an item.
+ * \param[in] pair_cmp The comparison used for the (key, index) pairs.
+ * \note      This macro is internal and should not be used.
+ */
+#define _sort_by_key(arr, size, key_fn, pair_cmp)                                            \
+    ({                                                                                       \
+        typedef _typeofarray((arr)) _sbk_type;                                               \
+        _sbk_type *_sbk_arr = (arr);                                                         \
+        const size_t _sbk_size = (size);                                                     \
+        __auto_type _sbk_key_fn = (key_fn);                                                  \
+        typedef typeof(_sbk_key_fn(*_sbk_arr)) _sbk_key_type;                                \
+        struct _sbk_pair {                                                                   \
+            _sbk_key_type key;                                                               \
+            size_t idx;                                                                      \
+        } *_sbk_pairs = HR_ALLOC(HR_GLOBAL_ALLOCATOR, sizeof(struct _sbk_pair) * _sbk_size); \
+        for (size_t _sbk_i = 0; _sbk_i < _sbk_size; _sbk_i++) {                              \
+            _sbk_pairs[_sbk_i].key = _sbk_key_fn(_sbk_arr[_sbk_i]);                          \
+            _sbk_pairs[_sbk_i].idx = _sbk_i;                                                 \
+        }                                                                                    \
+        sort(_sbk_pairs, _sbk_size, pair_cmp);                                               \
+        _sbk_type *_sbk_tmp = HR_ALLOC(HR_GLOBAL_ALLOCATOR, sizeof(_sbk_type) * _sbk_size);  \
+        for (size_t _sbk_i = 0; _sbk_i < _sbk_size; _sbk_i++)                                \
+            _sbk_tmp[_sbk_i] = _sbk_arr[_sbk_pairs[_sbk_i].idx];                             \
+        memcpy(_sbk_arr, _sbk_tmp, sizeof(_sbk_type) * _sbk_size);                           \
+        HR_DEALLOC(HR_GLOBAL_ALLOCATOR, _sbk_tmp);                                           \
+        HR_DEALLOC(HR_GLOBAL_ALLOCATOR, _sbk_pairs);                                         \
+    })
+
+/**
+ * \brief     A macro for sorting an array by a key extracted from each item.
+ * \note      The key function is called exactly once per item and the keys
+ *            are compared with the < and > operators, so the key must be an
+ *            arithmetic type. Items with equal keys keep their relative
+ *            order. Temporary buffers are allocated with the global
+ *            allocator.
+ * \param[in] arr The array to sort.
+ * \param[in] size The size of the array.
+ * \param[in] key_fn The function taking an item and returning its key.
+ */
+#define sort_by_key(arr, size, key_fn) _sort_by_key(arr, size, key_fn, _sort_key_pair_cmp)
+
+/**
+ * \brief     A macro for sorting an array by a key extracted from each item,
+ *            using a comparison function for the keys.
+ * \note      The key function is called exactly once per item, which makes
+ *            this useful for keys that are expensive to derive such as
+ *            normalised strings. Items with equal keys keep their relative
+ *            order. Temporary buffers are allocated with the global
+ *            allocator.
+ * \param[in] arr The array to sort.
+ * \param[in] size The size of the array.
+ * \param[in] key_fn The function taking an item and returning its key.
+ * \param[in] key_cmp The comparison function for the keys.
+ */
+#define sort_by_key_cmp(arr, size, key_fn, key_cmp)                                       \
+    _sort_by_key(arr, size, key_fn,                                                       \
+                 lambda(int, (const struct _sbk_pair _a, const struct _sbk_pair _b), {    \
+                     return key_cmp(_a.key, _b.key) ?: _sort_natural_cmp(_a.idx, _b.idx); \
+                 }))
+
+/**
+ * \brief     Internal comparison for the indices used by argsort.
+ * \note      Compares the items the indices refer to, breaking ties on the
+ *            index itself to keep argsort stable.
+ * \param[in] a The first index.
+ * \param[in] b The second index.
+ * \note      This macro is internal and should not be used.
+ */
+#define _argsort_cmp(a, b) (_as_cmp(_as_arr[(a)], _as_arr[(b)]) ?: _sort_natural_cmp((a), (b)))
+
+/**
+ * \brief     A macro for computing the sorted order of an array without
+ *            moving its items.
+ * \note      After this macro out_idx[i] holds the index of the item that
+ *            belongs at position i in sorted order. The array itself is
+ *            left untouched. Items that compare equal keep their relative
+ *            order.
+ * \param[in] arr The array to compute the order of.
+ * \param[in] size The size of the array.
+ * \param[in] cmp The comparison function for the items.
+ * \param[out] out_idx The array of size_t receiving the indices, must hold
+ *             at least size items.
+ */
+#define argsort(arr, size, cmp, out_idx)                  \
+    ({                                                    \
+        const _typeofarray((arr)) *_as_arr = (arr);       \
+        const size_t _as_size = (size);                   \
+        size_t *_as_idx = (out_idx);                      \
+        __auto_type _as_cmp = (cmp);                      \
+        for (size_t _as_i = 0; _as_i < _as_size; _as_i++) \
+            _as_idx[_as_i] = _as_i;                       \
+        sort(_as_idx, _as_size, _argsort_cmp);            \
+    })
+
+#define _PERMUTATION_MARK ((size_t)1 << (sizeof(size_t) * 8 - 1))
+
+/**
+ * \brief     A macro for reordering an array in place by a permutation.
+ * \note      After this macro arr[i] holds the item previously found at
+ *            arr[idx[i]], which makes it the counterpart of argsort. The
+ *            permutation is applied cycle by cycle, so every item is moved
+ *            once and no scratch array is needed. The index array is used
+ *            for bookkeeping while the macro runs but is restored before it
+ *            returns, so the same permutation can be applied to several
+ *            parallel arrays.
+ * \param[in] arr The array to reorder.
+ * \param[in] size The size of the array.
+ * \param[in] idx The permutation, a size_t array of size items.
+ */
+#define apply_permutation(arr, size, idx)                   \
+    ({                                                      \
+        _typeofarray((arr)) *_ap_arr = (arr);               \
+        const size_t _ap_size = (size);                     \
+        size_t *_ap_idx = (idx);                            \
+        for (size_t _ap_i = 0; _ap_i < _ap_size; _ap_i++) { \
+            if (_ap_idx[_ap_i] & _PERMUTATION_MARK)         \
+                continue;                                   \
+            _typeofarray(_ap_arr) _ap_tmp = _ap_arr[_ap_i]; \
+            size_t _ap_j = _ap_i;                           \
+            while (true) {                                  \
+                size_t _ap_k = _ap_idx[_ap_j];              \
+                _ap_idx[_ap_j] |= _PERMUTATION_MARK;        \
+                if (_ap_k == _ap_i)                         \
+                    break;                                  \
+                _ap_arr[_ap_j] = _ap_arr[_ap_k];            \
+                _ap_j = _ap_k;                              \
+            }                                               \
+            _ap_arr[_ap_j] = _ap_tmp;                       \
+        }                                                   \
+        for (size_t _ap_i = 0; _ap_i < _ap_size; _ap_i++)   \
+            _ap_idx[_ap_i] &= ~_PERMUTATION_MARK;           \
+    })
 
 #endif // HURUST_SORT_H
\ No newline at end of file
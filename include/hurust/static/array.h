@@ -42,6 +42,7 @@
 #include "../sort.h"
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 
 /**
  * \brief     A macro for defining an array.
@@ -188,14 +189,62 @@
  * \param[in] _array The array to pop the item from.
  * \param[in] _i The index of the item to pop.
  */
-#define array_pop(_array, _i)                                     \
-    ({                                                            \
-        _typeofarray((_array)->data) _ret = (_array)->data[(_i)]; \
-        (_array)->size--;                                         \
-        for (size_t _j = (_i); _j < (_array)->size; _j++) {       \
-            (_array)->data[_j] = (_array)->data[_j + 1];          \
-        }                                                         \
-        _ret;                                                     \
+#define array_pop(_array, _i)                                         \
+    ({                                                                \
+        const size_t _pop_i = (_i);                                   \
+        _typeofarray((_array)->data) _ret = (_array)->data[_pop_i];   \
+        (_array)->size--;                                             \
+        memmove((_array)->data + _pop_i, (_array)->data + _pop_i + 1, \
+                sizeof(*(_array)->data) * ((_array)->size - _pop_i)); \
+        _ret;                                                         \
+    })
+
+/**
+ * \brief     A macro for removing an item from an array without preserving
+ *            order.
+ * \note      This macro removes the item at the given index by moving the
+ *            last item into its place, which takes constant time.
+ * \param[in] _array The array to remove the item from.
+ * \param[in] _i The index of the item to remove.
+ */
+#define array_swap_remove(_array, _i)                                \
+    ({                                                               \
+        const size_t _swap_i = (_i);                                 \
+        _typeofarray((_array)->data) _ret = (_array)->data[_swap_i]; \
+        (_array)->data[_swap_i] = (_array)->data[--(_array)->size];  \
+        _ret;                                                        \
+    })
+
+/**
+ * \brief     A macro for keeping only the items of an array that match a
+ *            predicate.
+ * \note      This macro removes every item the predicate rejects in a single
+ *            linear pass, keeping the order of the remaining items.
+ * \param[in] _array The array to filter.
+ * \param[in] _pred The predicate, called with a pointer to each item and
+ *            returning true for items to keep.
+ * \return    The number of items removed.
+ */
+#define array_retain(_array, _pred)                                      \
+    ({                                                                   \
+        const size_t _ret_old = (_array)->size;                          \
+        (_array)->size = _retain_items((_array)->data, _ret_old, _pred); \
+        _ret_old - (_array)->size;                                       \
+    })
+
+/**
+ * \brief     A macro for removing adjacent duplicate items from an array.
+ * \note      This macro keeps the first item of every run of adjacent items
+ *            that compare equal with the comparison function of the array,
+ *            so a sorted array ends up with unique items.
+ * \param[in] _array The array to deduplicate.
+ * \return    The number of items removed.
+ */
+#define array_dedup(_array)                                                       \
+    ({                                                                            \
+        const size_t _dedup_old = (_array)->size;                                 \
+        (_array)->size = _dedup_items((_array)->data, _dedup_old, (_array)->cmp); \
+        _dedup_old - (_array)->size;                                              \
     })
 
 /**
@@ -245,10 +294,21 @@
 /**
  * \brief     A macro for sorting an array.
  * \note      This macro sorts an array using the comparison function
- *            specified when initializing the array.
+ *            specified when initializing the array. Arrays of 32 and 64
+ *            bit integers, float and double are sorted by the SIMD kernel
+ *            first, see sort_dispatch.
+ * \param[in] _array The array to sort.
+ */
+#define array_sort(_array) ({ sort_dispatch((_array)->data, (_array)->size, (_array)->cmp); })
+
+/**
+ * \brief     A macro for sorting an array of primitive types in ascending order.
+ * \note      This macro sorts an array with sort_natural, ignoring the
+ *            comparison function. It should only be used on arithmetic
+ *            types.
  * \param[in] _array The array to sort.
  */
-#define array_sort(_array) ({ sort((_array)->data, (_array)->size, (_array)->cmp); })
+#define array_sort_natural(_array) ({ sort_natural((_array)->data, (_array)->size); })
 
 /**
  * \brief     A macro for getting the maximum item in an array.
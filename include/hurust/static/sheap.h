@@ -0,0 +1,243 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/*==========================================================================*
+
+  FILE
+    sheap.h
+
+  PROJECT
+    hurust generic library
+
+  DESCRIPTION
+    This file contains the static heap data structure and macros for using
+    it. The heap never grows, and once full it keeps the best items pushed
+    to it so far, which makes it a top-k collector.
+
+  PROGRAMMER
+    Callum Gran.
+
+  MODIFICATIONS
+    18-Oct-26  C.Gran		Created file.
+
+ *==========================================================================*/
+#ifndef HURUST_STATIC_HEAP_H
+#define HURUST_STATIC_HEAP_H
+
+#include "../alloc.h"
+#include "../common.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \brief     A macro for defining a static heap.
+ * \note      This macro defines a static heap with the given type and struct
+ *            prefix. Items that compare lower are better, like the front of
+ *            a HEAP, and the root of the static heap is the worst item kept
+ *            so it can be compared against and evicted in O(1).
+ * \param[in] type The type of the heap.
+ * \param[in] struct_prefix The prefix for the heap struct.
+ * \note      The struct prefix parameter is used to define the heap struct
+ *            name as some types such as pointers and heaps cannot be used
+ *            as struct names.
+ */
+#define SHEAP(type, struct_prefix)           \
+    typedef struct struct_prefix##_sheap_t { \
+        type *data;                          \
+        size_t size;                         \
+        size_t cap;                          \
+        int (*cmp)(const type, const type);  \
+        struct hr_allocator_t *allocator;    \
+    } struct_prefix##_sheap_t;
+
+/**
+ * \brief     Internal macro for moving the last item of a static heap up.
+ * \note      This macro moves the hole left by the item up past every parent
+ *            that is better than the item and writes the item once.
+ * \param[in] _heap The heap to heapify up.
+ * \note      This macro is internal and should not be used.
+ */
+#define _sheap_sift_up(_heap)                                           \
+    ({                                                                  \
+        size_t _su_idx = (_heap)->size - 1;                             \
+        _typeofarray((_heap)->data) _su_item = (_heap)->data[_su_idx];  \
+        while (_su_idx > 0) {                                           \
+            const size_t _su_parent = (_su_idx - 1) >> 1;               \
+            if ((_heap)->cmp(_su_item, (_heap)->data[_su_parent]) <= 0) \
+                break;                                                  \
+            (_heap)->data[_su_idx] = (_heap)->data[_su_parent];         \
+            _su_idx = _su_parent;                                       \
+        }                                                               \
+        (_heap)->data[_su_idx] = _su_item;                              \
+    })
+
+/**
+ * \brief     Internal macro for moving the root of a static heap down.
+ * \note      This macro moves the hole left by the root down past every
+ *            worse child and writes the root once.
+ * \param[in] _heap The heap to heapify down.
+ * \note      This macro is internal and should not be used.
+ */
+#define _sheap_sift_down(_heap)                                                           \
+    ({                                                                                    \
+        size_t _sd_idx = 0;                                                               \
+        size_t _sd_child;                                                                 \
+        _typeofarray((_heap)->data) _sd_item = (_heap)->data[0];                          \
+        while ((_sd_child = (_sd_idx << 1) + 1) < (_heap)->size) {                        \
+            if (_sd_child + 1 < (_heap)->size &&                                          \
+                (_heap)->cmp((_heap)->data[_sd_child + 1], (_heap)->data[_sd_child]) > 0) \
+                _sd_child++;                                                              \
+            if ((_heap)->cmp((_heap)->data[_sd_child], _sd_item) <= 0)                    \
+                break;                                                                    \
+            (_heap)->data[_sd_idx] = (_heap)->data[_sd_child];                            \
+            _sd_idx = _sd_child;                                                          \
+        }                                                                                 \
+        (_heap)->data[_sd_idx] = _sd_item;                                                \
+    })
+
+/**
+ * \brief     A macro for initializing a static heap.
+ * \note      This macro initializes a static heap with the given allocator,
+ *            capacity and comparison function. The capacity is the number
+ *            of best items kept and is allocated once.
+ * \param[in] _heap The heap to initialize.
+ * \param[in] _allocator The allocator to use for the heap.
+ * \param[in] _cap The capacity of the heap.
+ * \param[in] _cmp The comparison function, lower items are better.
+ */
+#define sheap_init(_heap, _allocator, _cap, _cmp)                                            \
+    ({                                                                                       \
+        (_heap)->allocator = (_allocator);                                                   \
+        (_heap)->cap = (_cap);                                                               \
+        (_heap)->size = 0;                                                                   \
+        (_heap)->cmp = (_cmp);                                                               \
+        (_heap)->data = HR_ALLOC((_heap)->allocator, sizeof(*(_heap)->data) * (_heap)->cap); \
+    })
+
+/**
+ * \brief     A macro for freeing a static heap.
+ * \note      This macro frees a static heap using the allocator specified
+ *            when initializing the heap.
+ * \param[in] _heap The heap to free.
+ */
+#define sheap_free(_heap) ({ HR_DEALLOC((_heap)->allocator, (_heap)->data); })
+
+// Getters
+
+/**
+ * \brief     A macro for getting the size of a static heap.
+ * \note      This macro gets the size of a static heap.
+ * \param[in] _heap The heap to get the size of.
+ */
+#define sheap_get_size(_heap) ({ (_heap)->size; })
+
+/**
+ * \brief     A macro for getting the capacity of a static heap.
+ * \note      This macro gets the capacity of a static heap.
+ * \param[in] _heap The heap to get the capacity of.
+ */
+#define sheap_get_cap(_heap) ({ (_heap)->cap; })
+
+/**
+ * \brief     A macro for getting the data of a static heap.
+ * \note      This macro gets the data of a static heap, which is in heap
+ *            order and not sorted.
+ * \param[in] _heap The heap to get the data of.
+ */
+#define sheap_get_data(_heap) ({ (_heap)->data; })
+
+/**
+ * \brief     A macro for checking if a static heap is empty.
+ * \param[in] _heap The heap to check.
+ */
+#define sheap_empty(_heap) ({ (_heap)->size == 0; })
+
+/**
+ * \brief     A macro for checking if a static heap is full.
+ * \param[in] _heap The heap to check.
+ */
+#define sheap_full(_heap) ({ (_heap)->size == (_heap)->cap; })
+
+/**
+ * \brief     A macro for clearing a static heap.
+ * \param[in] _heap The heap to clear.
+ */
+#define sheap_clear(_heap) ({ (_heap)->size = 0; })
+
+/**
+ * \brief     A macro for pushing an item to a static heap.
+ * \note      This macro adds the item while the heap is not full. Once it is
+ *            full, an item that is not better than the worst item kept is
+ *            rejected with a single comparison, and a better one takes the
+ *            place of the worst item, so the heap never grows.
+ * \param[in] _heap The heap to push the item to.
+ * \param[in] _item The item to push to the heap.
+ * \return    True if the item was kept, false if it was rejected.
+ */
+#define sheap_push(_heap, _item)                                   \
+    ({                                                             \
+        bool _ret = true;                                          \
+        if ((_heap)->size < (_heap)->cap) {                        \
+            (_heap)->data[(_heap)->size++] = *(_item);             \
+            _sheap_sift_up(_heap);                                 \
+        } else if ((_heap)->cap > 0 &&                             \
+                   (_heap)->cmp(*(_item), (_heap)->data[0]) < 0) { \
+            (_heap)->data[0] = *(_item);                           \
+            _sheap_sift_down(_heap);                               \
+        } else {                                                   \
+            _ret = false;                                          \
+        }                                                          \
+        _ret;                                                      \
+    })
+
+/**
+ * \brief     A macro for getting the worst item kept by a static heap.
+ * \note      Once the heap is full, only items better than this one are
+ *            kept. This macro does not pop the item from the heap.
+ * \param[in] _heap The heap to get the item from.
+ */
+#define sheap_peek(_heap) ({ (_heap)->data[0]; })
+
+/**
+ * \brief     A macro for popping the worst item kept by a static heap.
+ * \param[in] _heap The heap to pop the item from.
+ */
+#define sheap_pop(_heap)                                     \
+    ({                                                       \
+        _typeofarray((_heap)->data) _ret = (_heap)->data[0]; \
+        (_heap)->data[0] = (_heap)->data[--(_heap)->size];   \
+        _sheap_sift_down(_heap);                             \
+        _ret;                                                \
+    })
+
+/**
+ * \brief     A macro for draining a static heap into a sorted array.
+ * \note      This macro moves every item of the heap to the given array,
+ *            best item first, and leaves the heap empty.
+ * \param[in] _heap The heap to drain.
+ * \param[out] _out The array to write the items to, with room for the size
+ *             of the heap.
+ * \return    The number of items written.
+ */
+#define sheap_drain(_heap, _out)                       \
+    ({                                                 \
+        const size_t _dr_n = (_heap)->size;            \
+        for (size_t _dr_i = _dr_n; _dr_i > 0; _dr_i--) \
+            (_out)[_dr_i - 1] = sheap_pop(_heap);      \
+        _dr_n;                                         \
+    })
+
+#endif // HURUST_STATIC_HEAP_H
@@ -0,0 +1,142 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../include/hurust/dynamic/dheap.h"
+#include "../../include/hurust/functional/lambda.h"
+
+struct timer {
+    uint64_t deadline;
+    uint64_t id;
+};
+
+void test_int_push_pop(void)
+{
+    DHEAP(int, int, 4);
+
+    struct int_dheap_t heap;
+    dheap_init(&heap, HR_GLOBAL_ALLOCATOR, 1,
+               lambda(int, (const int a, const int b), { return (a > b) - (a < b); }));
+
+    assert(dheap_get_arity(&heap) == 4);
+    assert(dheap_empty(&heap));
+
+    int item = 3;
+    dheap_push(&heap, &item);
+    assert(dheap_peek(&heap) == 3);
+    assert(dheap_pop(&heap) == 3);
+    assert(dheap_empty(&heap));
+
+    srand(42);
+    for (int i = 0; i < 10000; i++) {
+        item = rand() % 1000;
+        dheap_push(&heap, &item);
+        assert(((uintptr_t)(dheap_get_data(&heap) + 1)) % HR_DHEAP_ALIGN == 0);
+    }
+
+    int prev = dheap_pop(&heap);
+    while (!dheap_empty(&heap)) {
+        int next = dheap_pop(&heap);
+        assert(prev <= next);
+        assert(((uintptr_t)(dheap_get_data(&heap) + 1)) % HR_DHEAP_ALIGN == 0);
+        prev = next;
+    }
+
+    dheap_free(&heap);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer push pop d-ary heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_long_from_array(void)
+{
+    DHEAP(long, long, 8);
+
+    struct long_dheap_t heap;
+    dheap_init(&heap, HR_GLOBAL_ALLOCATOR, 4,
+               lambda(int, (const long a, const long b), { return (a > b) - (a < b); }));
+
+    for (size_t n = 0; n < 100; n++) {
+        long arr[100];
+        for (size_t i = 0; i < n; i++)
+            arr[i] = (long)((i * 7919) % 101);
+
+        dheap_from_array(&heap, arr, n);
+        assert(dheap_get_size(&heap) == n);
+
+        long prev = -1;
+        while (!dheap_empty(&heap)) {
+            long next = dheap_pop(&heap);
+            assert(prev <= next);
+            prev = next;
+        }
+    }
+
+    dheap_free(&heap);
+
+    printf("------------------------------------------\n");
+    printf("Completed long from array d-ary heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_timer_struct(void)
+{
+    DHEAP(struct timer, timer, 4);
+
+    struct timer_dheap_t heap;
+    dheap_init(&heap, HR_GLOBAL_ALLOCATOR, 16,
+               lambda(int, (const struct timer a, const struct timer b), {
+                   return (a.deadline > b.deadline) - (a.deadline < b.deadline);
+               }));
+
+    for (uint64_t i = 0; i < 1000; i++) {
+        struct timer t = { .deadline = (i * 37) % 1000, .id = i };
+        dheap_push(&heap, &t);
+    }
+
+    /* Four 16 byte timers fill exactly one cache line. */
+    assert(((uintptr_t)(dheap_get_data(&heap) + 1)) % HR_DHEAP_ALIGN == 0);
+
+    for (uint64_t i = 0; i < 1000; i++) {
+        struct timer t = dheap_pop(&heap);
+        assert(t.deadline == i);
+        assert((t.id * 37) % 1000 == i);
+    }
+
+    assert(dheap_empty(&heap));
+
+    dheap_free(&heap);
+
+    printf("------------------------------------------\n");
+    printf("Completed struct timer d-ary heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+int main(void)
+{
+    printf("Running dynamic d-ary heap tests...\n");
+    test_int_push_pop();
+    test_long_from_array();
+    test_timer_struct();
+    printf("Completed dynamic d-ary heap tests!\n");
+    return 0;
+}
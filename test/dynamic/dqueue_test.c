@@ -110,10 +110,88 @@ void test_str_push_pop_get(void)
     printf("-----------------------------------------\n");
 }
 
+void test_int_wrapped_growth(void)
+{
+    DQUEUE(int, int);
+
+    struct int_dqueue_t queue;
+    dqueue_init(&queue, HR_GLOBAL_ALLOCATOR, 4);
+
+    const HRGrowthPolicy policy = {
+        .growth_factor = 1.5f, .shrink_threshold = 4, .min_cap = 1, .never_shrink = false
+    };
+    dqueue_set_policy(&queue, &policy);
+
+    int next_push = 0;
+    int next_pop = 0;
+
+    for (int round = 0; round < 50; round++) {
+        for (int i = 0; i < 3; i++)
+            dqueue_push(&queue, &(int){ next_push++ });
+        for (int i = 0; i < 2; i++)
+            assert(dqueue_pop(&queue) == next_pop++);
+    }
+
+    assert(dqueue_get_size(&queue) == (size_t)(next_push - next_pop));
+
+    while (!dqueue_empty(&queue))
+        assert(dqueue_pop(&queue) == next_pop++);
+
+    assert(next_pop == next_push);
+
+    dqueue_free(&queue);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer wrapped growth queue tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_record_emplace(void)
+{
+    struct record {
+        int key;
+        char payload[252];
+    };
+
+    DQUEUE(struct record, record);
+
+    struct record_dqueue_t queue;
+    dqueue_init(&queue, HR_GLOBAL_ALLOCATOR, 4);
+
+    int next_push = 0;
+    int next_pop = 0;
+
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 7; i++) {
+            struct record *slot = dqueue_emplace(&queue);
+            slot->key = next_push;
+            memset(slot->payload, next_push++, sizeof(slot->payload));
+        }
+        for (int i = 0; i < 5; i++) {
+            struct record pop = dqueue_pop(&queue);
+            assert(pop.key == next_pop);
+            assert(pop.payload[100] == (char)next_pop++);
+        }
+    }
+
+    while (!dqueue_empty(&queue))
+        assert(dqueue_pop(&queue).key == next_pop++);
+
+    assert(next_pop == next_push);
+
+    dqueue_free(&queue);
+
+    printf("------------------------------------------\n");
+    printf("Completed record emplace queue tests\n");
+    printf("------------------------------------------\n");
+}
+
 int main(void)
 {
     printf("Running dynamic queue tests...\n");
     test_int_push_pop_get();
     test_str_push_pop_get();
+    test_int_wrapped_growth();
+    test_record_emplace();
     return 0;
 }
\ No newline at end of file
@@ -110,10 +110,44 @@ void test_str_push_pop_get(void)
     printf("-----------------------------------------\n");
 }
 
+void test_record_emplace(void)
+{
+    struct record {
+        int key;
+        char payload[252];
+    };
+
+    DSTACK(struct record, record);
+
+    struct record_dstack_t stack;
+    dstack_init(&stack, HR_GLOBAL_ALLOCATOR, 1);
+
+    for (int i = 0; i < 100; i++) {
+        struct record *slot = dstack_emplace(&stack);
+        slot->key = i;
+        memset(slot->payload, i, sizeof(slot->payload));
+    }
+
+    for (int i = 99; i >= 0; i--) {
+        struct record pop = dstack_pop(&stack);
+        assert(pop.key == i);
+        assert(pop.payload[0] == (char)i);
+    }
+
+    assert(dstack_empty(&stack));
+
+    dstack_free(&stack);
+
+    printf("-----------------------------------------\n");
+    printf("Completed record emplace stack tests\n");
+    printf("-----------------------------------------\n");
+}
+
 int main(void)
 {
     printf("Running dynamic stack tests...\n");
     test_int_push_pop_get();
     test_str_push_pop_get();
+    test_record_emplace();
     return 0;
 }
\ No newline at end of file
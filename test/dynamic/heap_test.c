@@ -17,6 +17,7 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "../../include/hurust/dynamic/heap.h"
@@ -133,10 +134,222 @@ void test_str_push_pop_get(void)
     printf("-----------------------------------------\n");
 }
 
+void test_record_emplace(void)
+{
+    struct record {
+        int key;
+        char payload[252];
+    };
+
+    HEAP(struct record, record);
+
+    struct record_heap_t heap;
+    heap_init(&heap, HR_GLOBAL_ALLOCATOR, 1,
+              lambda(int, (const struct record a, const struct record b),
+                     { return a.key - b.key; }));
+
+    for (int i = 0; i < 100; i++) {
+        struct record *slot = heap_emplace(&heap);
+        slot->key = (i * 37) % 100;
+        memset(slot->payload, slot->key, sizeof(slot->payload));
+        heap_emplace_commit(&heap);
+    }
+
+    for (int i = 0; i < 100; i++) {
+        struct record pop = heap_pop(&heap);
+        assert(pop.key == i);
+        assert(pop.payload[17] == (char)i);
+    }
+
+    assert(heap_empty(&heap));
+
+    heap_free(&heap);
+
+    printf("------------------------------------------\n");
+    printf("Completed record emplace heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_int_from_array_bulk(void)
+{
+    HEAP(int, int);
+
+    struct int_heap_t heap;
+    heap_init(&heap, HR_GLOBAL_ALLOCATOR, 1,
+              lambda(int, (const int a, const int b), { return a - b; }));
+
+    const size_t n = 100000;
+    int *items = malloc(sizeof(int) * n);
+    srand(7);
+    for (size_t i = 0; i < n; i++)
+        items[i] = rand() % 50000;
+
+    static size_t cmp_count = 0;
+    heap_set_cmp(&heap, lambda(int, (const int a, const int b), {
+                     cmp_count++;
+                     return a - b;
+                 }));
+
+    heap_from_array(&heap, items, n);
+
+    /* Floyd's method does at most two comparisons per level moved. */
+    assert(cmp_count < 4 * n);
+    assert(heap_get_size(&heap) == n);
+
+    int prev = heap_pop(&heap);
+    for (size_t i = 1; i < n; i++) {
+        int pop = heap_pop(&heap);
+        assert(prev <= pop);
+        prev = pop;
+    }
+
+    assert(heap_empty(&heap));
+
+    heap_push_bulk(&heap, items, 1000);
+    heap_push_bulk(&heap, items + 1000, 10);
+    heap_push_bulk(&heap, items + 1010, 0);
+    heap_push_bulk(&heap, items + 1010, 5000);
+
+    assert(heap_get_size(&heap) == 6010);
+
+    prev = heap_pop(&heap);
+    for (size_t i = 1; i < 6010; i++) {
+        int pop = heap_pop(&heap);
+        assert(prev <= pop);
+        prev = pop;
+    }
+
+    heap_from_array(&heap, items, 0);
+    assert(heap_empty(&heap));
+
+    free(items);
+    heap_free(&heap);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer from array bulk heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_int_pop_bottom_up(void)
+{
+    HEAP(int, int);
+
+    static size_t cmp_count = 0;
+    int (*counting_cmp)(const int, const int) = lambda(int, (const int a, const int b), {
+        cmp_count++;
+        return (a > b) - (a < b);
+    });
+
+    struct int_heap_t heap;
+    struct int_heap_t bottom_up;
+    heap_init(&heap, HR_GLOBAL_ALLOCATOR, 1, counting_cmp);
+    heap_init(&bottom_up, HR_GLOBAL_ALLOCATOR, 1, counting_cmp);
+
+    const size_t n = 100000;
+    int *items = malloc(sizeof(int) * n);
+    srand(11);
+    for (size_t i = 0; i < n; i++)
+        items[i] = rand();
+
+    heap_from_array(&heap, items, n);
+    heap_from_array(&bottom_up, items, n);
+
+    cmp_count = 0;
+    for (size_t i = 0; i < n; i++)
+        items[i] = heap_pop(&heap);
+    size_t pop_cmps = cmp_count;
+
+    cmp_count = 0;
+    for (size_t i = 0; i < n; i++)
+        assert(heap_pop_bottom_up(&bottom_up) == items[i]);
+    size_t bottom_up_cmps = cmp_count;
+
+    for (size_t i = 1; i < n; i++)
+        assert(items[i - 1] <= items[i]);
+
+    assert(heap_empty(&bottom_up));
+    assert(bottom_up_cmps * 3 < pop_cmps * 2);
+
+    int item = 5;
+    heap_push(&bottom_up, &item);
+    assert(heap_pop_bottom_up(&bottom_up) == 5);
+    assert(heap_empty(&bottom_up));
+
+    free(items);
+    heap_free(&heap);
+    heap_free(&bottom_up);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer pop bottom up heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_int_pushpop_replace(void)
+{
+    HEAP(int, int);
+
+    static size_t cmp_count = 0;
+    int (*counting_cmp)(const int, const int) = lambda(int, (const int a, const int b), {
+        cmp_count++;
+        return (a > b) - (a < b);
+    });
+
+    struct int_heap_t fused;
+    struct int_heap_t reference;
+    heap_init(&fused, HR_GLOBAL_ALLOCATOR, 1, counting_cmp);
+    heap_init(&reference, HR_GLOBAL_ALLOCATOR, 1, counting_cmp);
+
+    /* Pushpop on an empty heap gives the item back. */
+    assert(heap_pushpop(&fused, &(int){ 3 }) == 3);
+    assert(heap_empty(&fused));
+
+    srand(13);
+    for (int i = 0; i < 100; i++) {
+        int item = rand() % 1000;
+        heap_push(&fused, &item);
+        heap_push(&reference, &item);
+    }
+
+    for (int i = 0; i < 10000; i++) {
+        int item = rand() % 1000;
+        if (i % 2 == 0) {
+            heap_push(&reference, &item);
+            assert(heap_pushpop(&fused, &item) == heap_pop(&reference));
+        } else {
+            int expected = heap_pop(&reference);
+            heap_push(&reference, &item);
+            assert(heap_replace(&fused, &item) == expected);
+        }
+        assert(heap_get_size(&fused) == 100);
+        assert(heap_peek(&fused) == heap_peek(&reference));
+    }
+
+    /* An item that would be the front is returned after one comparison. */
+    int front = heap_peek(&fused);
+    cmp_count = 0;
+    assert(heap_pushpop(&fused, &(int){ -1 }) == -1);
+    assert(cmp_count == 1);
+    assert(heap_peek(&fused) == front);
+
+    while (!heap_empty(&fused))
+        assert(heap_pop(&fused) == heap_pop(&reference));
+
+    heap_free(&fused);
+    heap_free(&reference);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer pushpop replace heap tests\n");
+    printf("------------------------------------------\n");
+}
+
 int main(void)
 {
     printf("Running heap tests...\n");
     test_int_push_pop_get();
     test_str_push_pop_get();
+    test_record_emplace();
+    test_int_from_array_bulk();
+    test_int_pop_bottom_up();
+    test_int_pushpop_replace();
     return 0;
 }
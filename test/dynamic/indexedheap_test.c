@@ -0,0 +1,157 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../include/hurust/dynamic/indexedheap.h"
+#include "../../include/hurust/functional/lambda.h"
+
+#define NODES 200
+#define INF UINT64_MAX
+
+void test_int_handles(void)
+{
+    INDEXED_HEAP(int, int);
+
+    struct int_indexed_heap_t heap;
+    indexed_heap_init(&heap, HR_GLOBAL_ALLOCATOR, 1,
+                      lambda(int, (const int a, const int b), { return (a > b) - (a < b); }));
+
+    assert(indexed_heap_empty(&heap));
+
+    size_t handles[10];
+    for (int i = 0; i < 10; i++)
+        handles[i] = indexed_heap_push(&heap, &(int){ (i * 7) % 10 + 10 });
+
+    assert(indexed_heap_get_size(&heap) == 10);
+    assert(indexed_heap_peek(&heap) == 10);
+
+    for (int i = 0; i < 10; i++) {
+        assert(indexed_heap_contains(&heap, handles[i]));
+        assert(indexed_heap_get(&heap, handles[i]) == (i * 7) % 10 + 10);
+    }
+
+    /* The 17 becomes the front and the 10 moves to the back. */
+    indexed_heap_decrease_key(&heap, handles[1], &(int){ 1 });
+    assert(indexed_heap_peek_handle(&heap) == handles[1]);
+    indexed_heap_increase_key(&heap, handles[0], &(int){ 100 });
+    indexed_heap_update(&heap, handles[2], &(int){ 0 });
+    assert(indexed_heap_peek_handle(&heap) == handles[2]);
+    indexed_heap_update(&heap, handles[2], &(int){ 50 });
+    assert(indexed_heap_peek_handle(&heap) == handles[1]);
+
+    assert(indexed_heap_remove(&heap, handles[3]) == 11);
+    assert(!indexed_heap_contains(&heap, handles[3]));
+    assert(indexed_heap_get_size(&heap) == 9);
+
+    /* The freed handle is reused by the next push. */
+    assert(indexed_heap_push(&heap, &(int){ 5 }) == handles[3]);
+
+    int expected[] = { 1, 5, 12, 13, 15, 16, 18, 19, 50, 100 };
+    for (int i = 0; i < 10; i++)
+        assert(indexed_heap_pop(&heap) == expected[i]);
+
+    assert(indexed_heap_empty(&heap));
+    for (int i = 0; i < 10; i++)
+        assert(!indexed_heap_contains(&heap, handles[i]));
+
+    indexed_heap_free(&heap);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer handle indexed heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_dijkstra(void)
+{
+    INDEXED_HEAP(uint64_t, dist);
+
+    static uint64_t weight[NODES][NODES];
+    srand(3);
+    for (size_t u = 0; u < NODES; u++)
+        for (size_t v = 0; v < NODES; v++)
+            weight[u][v] = u != v && rand() % 8 == 0 ? (uint64_t)(rand() % 1000 + 1) : INF;
+
+    /* Reference distances from the quadratic version of the algorithm. */
+    uint64_t expected[NODES];
+    bool done[NODES] = { false };
+    for (size_t v = 0; v < NODES; v++)
+        expected[v] = INF;
+    expected[0] = 0;
+    for (size_t i = 0; i < NODES; i++) {
+        size_t u = NODES;
+        for (size_t v = 0; v < NODES; v++)
+            if (!done[v] && expected[v] != INF && (u == NODES || expected[v] < expected[u]))
+                u = v;
+        if (u == NODES)
+            break;
+        done[u] = true;
+        for (size_t v = 0; v < NODES; v++)
+            if (weight[u][v] != INF && expected[u] + weight[u][v] < expected[v])
+                expected[v] = expected[u] + weight[u][v];
+    }
+
+    struct dist_indexed_heap_t heap;
+    indexed_heap_init(&heap, HR_GLOBAL_ALLOCATOR, NODES,
+                      lambda(int, (const uint64_t a, const uint64_t b),
+                             { return (a > b) - (a < b); }));
+
+    /* Every node is pushed once, so its handle is its index. */
+    for (size_t v = 0; v < NODES; v++)
+        assert(indexed_heap_push(&heap, &(uint64_t){ v == 0 ? 0 : INF }) == v);
+
+    uint64_t dist[NODES];
+    size_t max_size = 0;
+    while (!indexed_heap_empty(&heap)) {
+        if (indexed_heap_get_size(&heap) > max_size)
+            max_size = indexed_heap_get_size(&heap);
+        size_t u = indexed_heap_peek_handle(&heap);
+        dist[u] = indexed_heap_pop(&heap);
+        if (dist[u] == INF)
+            continue;
+        for (size_t v = 0; v < NODES; v++) {
+            if (weight[u][v] == INF || !indexed_heap_contains(&heap, v))
+                continue;
+            uint64_t alt = dist[u] + weight[u][v];
+            if (alt < indexed_heap_get(&heap, v))
+                indexed_heap_decrease_key(&heap, v, &alt);
+        }
+    }
+
+    assert(max_size == NODES);
+    for (size_t v = 0; v < NODES; v++)
+        assert(dist[v] == expected[v]);
+
+    indexed_heap_free(&heap);
+
+    printf("------------------------------------------\n");
+    printf("Completed dijkstra indexed heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+int main(void)
+{
+    printf("Running dynamic indexed heap tests...\n");
+    test_int_handles();
+    test_dijkstra();
+    printf("Completed dynamic indexed heap tests!\n");
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/hurust/dynamic/minmaxheap.h"
+#include "../../include/hurust/functional/lambda.h"
+
+/* Sorted reference the heap is checked against. */
+static int ref[4096];
+static size_t ref_size = 0;
+
+static void ref_insert(int item)
+{
+    size_t i = ref_size++;
+    while (i > 0 && ref[i - 1] > item) {
+        ref[i] = ref[i - 1];
+        i--;
+    }
+    ref[i] = item;
+}
+
+void test_int_random_ops(void)
+{
+    MINMAX_HEAP(int, int);
+
+    struct int_minmax_heap_t heap;
+    minmax_heap_init(&heap, HR_GLOBAL_ALLOCATOR, 1,
+                     lambda(int, (const int a, const int b), { return (a > b) - (a < b); }));
+
+    assert(minmax_heap_empty(&heap));
+
+    int item = 7;
+    minmax_heap_push(&heap, &item);
+    assert(minmax_heap_peek_min(&heap) == 7);
+    assert(minmax_heap_peek_max(&heap) == 7);
+    assert(minmax_heap_pop_max(&heap) == 7);
+    assert(minmax_heap_empty(&heap));
+
+    srand(17);
+    for (int i = 0; i < 200000; i++) {
+        int op = rand() % 5;
+        if (ref_size == 0 || (op < 3 && ref_size < 4096)) {
+            item = rand() % 1000;
+            minmax_heap_push(&heap, &item);
+            ref_insert(item);
+        } else if (op == 3) {
+            assert(minmax_heap_pop_min(&heap) == ref[0]);
+            memmove(ref, ref + 1, sizeof(int) * --ref_size);
+        } else {
+            assert(minmax_heap_pop_max(&heap) == ref[--ref_size]);
+        }
+        assert(minmax_heap_get_size(&heap) == ref_size);
+        if (ref_size > 0) {
+            assert(minmax_heap_peek_min(&heap) == ref[0]);
+            assert(minmax_heap_peek_max(&heap) == ref[ref_size - 1]);
+        }
+    }
+
+    while (ref_size > 0) {
+        assert(minmax_heap_pop_max(&heap) == ref[--ref_size]);
+        if (ref_size > 0)
+            assert(minmax_heap_peek_min(&heap) == ref[0]);
+    }
+
+    assert(minmax_heap_empty(&heap));
+
+    minmax_heap_free(&heap);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer random ops min-max heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_int_from_array(void)
+{
+    MINMAX_HEAP(int, int);
+
+    struct int_minmax_heap_t heap;
+    minmax_heap_init(&heap, HR_GLOBAL_ALLOCATOR, 4,
+                     lambda(int, (const int a, const int b), { return (a > b) - (a < b); }));
+
+    for (int n = 0; n < 200; n++) {
+        int arr[200];
+        for (int i = 0; i < n; i++)
+            arr[i] = (i * 7919) % 211;
+
+        minmax_heap_from_array(&heap, arr, n);
+        assert(minmax_heap_get_size(&heap) == (size_t)n);
+
+        int lo = -1;
+        int hi = 1000;
+        while (!minmax_heap_empty(&heap)) {
+            int next = minmax_heap_get_size(&heap) % 2 ? minmax_heap_pop_min(&heap)
+                                                       : minmax_heap_pop_max(&heap);
+            assert(next >= lo && next <= hi);
+            if (minmax_heap_get_size(&heap) % 2)
+                hi = next;
+            else
+                lo = next;
+        }
+    }
+
+    minmax_heap_free(&heap);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer from array min-max heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+int main(void)
+{
+    printf("Running dynamic min-max heap tests...\n");
+    test_int_random_ops();
+    test_int_from_array();
+    printf("Completed dynamic min-max heap tests!\n");
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../include/hurust/dynamic/multiqueue.h"
+#include "../../include/hurust/functional/lambda.h"
+
+#define THREADS 8
+#define ITEMS_PER_THREAD 50000
+
+MULTIQUEUE(long, long);
+
+static struct long_multiqueue_t queue;
+static long sums[THREADS];
+static size_t pops[THREADS];
+
+static int long_cmp(const long a, const long b)
+{
+    return (a > b) - (a < b);
+}
+
+void test_int_single_thread(void)
+{
+    MULTIQUEUE(int, int);
+
+    struct int_multiqueue_t mq;
+    multiqueue_init(&mq, HR_GLOBAL_ALLOCATOR, 4,
+                    lambda(int, (const int a, const int b), { return (a > b) - (a < b); }));
+
+    assert(multiqueue_empty(&mq));
+    assert(multiqueue_get_nshards(&mq) == 4);
+    assert(((uintptr_t)mq.shards & (HR_MULTIQUEUE_ALIGN - 1)) == 0);
+
+    int out;
+    assert(!multiqueue_pop(&mq, &out));
+
+    int counts[1000] = { 0 };
+    for (int i = 0; i < 1000; i++) {
+        int item = (i * 7919) % 1000;
+        counts[item]++;
+        multiqueue_push(&mq, &item);
+    }
+    assert(multiqueue_get_size(&mq) == 1000);
+
+    /* The order is relaxed, but every item comes out close to its rank. */
+    for (int i = 0; i < 1000; i++) {
+        assert(multiqueue_pop(&mq, &out));
+        assert(out < i + 200);
+        counts[out]--;
+    }
+
+    assert(multiqueue_empty(&mq));
+    assert(!multiqueue_pop(&mq, &out));
+    for (int i = 0; i < 1000; i++)
+        assert(counts[i] == 0);
+
+    multiqueue_free(&mq);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer single thread multiqueue tests\n");
+    printf("------------------------------------------\n");
+}
+
+static void *worker(void *arg)
+{
+    size_t id = (size_t)arg;
+    long sum = 0;
+    size_t popped = 0;
+    for (long i = 0; i < ITEMS_PER_THREAD; i++) {
+        long item = (long)id * ITEMS_PER_THREAD + i;
+        multiqueue_push(&queue, &item);
+        if (i % 2) {
+            long out;
+            if (multiqueue_pop(&queue, &out)) {
+                sum += out;
+                popped++;
+            }
+        }
+    }
+    long out;
+    while (multiqueue_pop(&queue, &out)) {
+        sum += out;
+        popped++;
+    }
+    sums[id] = sum;
+    pops[id] = popped;
+    return NULL;
+}
+
+void test_long_threads(void)
+{
+    multiqueue_init(&queue, HR_GLOBAL_ALLOCATOR, THREADS * 2, long_cmp);
+
+    pthread_t threads[THREADS];
+    for (size_t i = 0; i < THREADS; i++)
+        pthread_create(&threads[i], NULL, worker, (void *)i);
+    for (size_t i = 0; i < THREADS; i++)
+        pthread_join(threads[i], NULL);
+
+    /* Every pushed item was popped exactly once. */
+    long n = (long)THREADS * ITEMS_PER_THREAD;
+    long sum = 0;
+    size_t popped = 0;
+    for (size_t i = 0; i < THREADS; i++) {
+        sum += sums[i];
+        popped += pops[i];
+    }
+    assert(popped == (size_t)n);
+    assert(sum == n * (n - 1) / 2);
+    assert(multiqueue_empty(&queue));
+
+    multiqueue_free(&queue);
+
+    printf("------------------------------------------\n");
+    printf("Completed long multi thread multiqueue tests\n");
+    printf("------------------------------------------\n");
+}
+
+int main(void)
+{
+    printf("Running dynamic multiqueue tests...\n");
+    test_int_single_thread();
+    test_long_threads();
+    printf("Completed dynamic multiqueue tests!\n");
+    return 0;
+}
@@ -0,0 +1,207 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/hurust/dynamic/pairingheap.h"
+#include "../../include/hurust/functional/lambda.h"
+
+/* A pool of fixed size blocks that recycles freed blocks through a free list. */
+struct pool {
+    char *blocks;
+    size_t block_size;
+    size_t used;
+    size_t cap;
+    void *free_list;
+    size_t live;
+};
+
+void *pool_alloc(void *arena, size_t size)
+{
+    struct pool *pool = arena;
+    assert(size <= pool->block_size);
+    pool->live++;
+    if (pool->free_list != NULL) {
+        void *block = pool->free_list;
+        pool->free_list = *(void **)block;
+        return block;
+    }
+    assert(pool->used < pool->cap);
+    return pool->blocks + pool->block_size * pool->used++;
+}
+
+void pool_dealloc(void *arena, void *ptr)
+{
+    struct pool *pool = arena;
+    pool->live--;
+    *(void **)ptr = pool->free_list;
+    pool->free_list = ptr;
+}
+
+void test_int_push_pop_meld(void)
+{
+    PAIRING_HEAP(int, int);
+
+    struct pool pool = { .block_size = sizeof(struct int_pairing_heap_node_t), .cap = 20000 };
+    pool.blocks = malloc(pool.block_size * pool.cap);
+    HR_ALLOCATOR_INIT(pool_allocator, &pool, pool_alloc, NULL, pool_dealloc);
+
+    int (*cmp)(const int, const int) =
+        lambda(int, (const int a, const int b), { return (a > b) - (a < b); });
+
+    struct int_pairing_heap_t heap;
+    struct int_pairing_heap_t other;
+    pairing_heap_init(&heap, &pool_allocator, cmp);
+    pairing_heap_init(&other, &pool_allocator, cmp);
+
+    assert(pairing_heap_empty(&heap));
+
+    int item = 4;
+    pairing_heap_push(&heap, &item);
+    assert(pairing_heap_peek(&heap) == 4);
+    assert(pairing_heap_pop(&heap) == 4);
+    assert(pairing_heap_empty(&heap));
+    assert(pool.live == 0);
+
+    int counts[1000] = { 0 };
+    srand(21);
+    for (int i = 0; i < 5000; i++) {
+        item = rand() % 1000;
+        counts[item]++;
+        pairing_heap_push(i % 2 ? &heap : &other, &item);
+    }
+
+    assert(pairing_heap_get_size(&heap) == 2500);
+    assert(pairing_heap_get_size(&other) == 2500);
+
+    pairing_heap_meld(&heap, &other);
+
+    assert(pairing_heap_empty(&other));
+    assert(pairing_heap_get_size(&heap) == 5000);
+
+    /* Melding an empty heap changes nothing. */
+    pairing_heap_meld(&heap, &other);
+    assert(pairing_heap_get_size(&heap) == 5000);
+
+    int prev = -1;
+    for (int i = 0; i < 2500; i++) {
+        int pop = pairing_heap_pop(&heap);
+        assert(prev <= pop);
+        counts[pop]--;
+        prev = pop;
+    }
+
+    /* The recycled nodes of the popped items are used again. */
+    size_t used = pool.used;
+    for (int i = 0; i < 1000; i++) {
+        item = prev + rand() % 100;
+        if (item >= 1000)
+            item = 999;
+        counts[item]++;
+        pairing_heap_push(&heap, &item);
+    }
+    assert(pool.used == used);
+
+    while (!pairing_heap_empty(&heap)) {
+        int pop = pairing_heap_pop(&heap);
+        assert(prev <= pop);
+        counts[pop]--;
+        prev = pop;
+    }
+
+    for (int i = 0; i < 1000; i++)
+        assert(counts[i] == 0);
+    assert(pool.live == 0);
+
+    for (int i = 0; i < 100; i++)
+        pairing_heap_push(&heap, &i);
+    pairing_heap_pop(&heap);
+    pairing_heap_free(&heap);
+    pairing_heap_free(&other);
+
+    assert(pool.live == 0);
+
+    free(pool.blocks);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer push pop meld pairing heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_int_decrease_key(void)
+{
+    PAIRING_HEAP(int, int);
+
+    struct int_pairing_heap_t heap;
+    pairing_heap_init(&heap, HR_GLOBAL_ALLOCATOR,
+                      lambda(int, (const int a, const int b), { return (a > b) - (a < b); }));
+
+    struct int_pairing_heap_node_t *nodes[2000];
+    int values[2000];
+    for (int i = 0; i < 2000; i++) {
+        values[i] = 10000 + (i * 7919) % 2000;
+        nodes[i] = pairing_heap_push(&heap, &values[i]);
+    }
+
+    /* Pop the first node so the heap is no longer a flat list of children. */
+    int front = pairing_heap_pop(&heap);
+    assert(front == values[0]);
+
+    srand(23);
+    for (int round = 0; round < 5000; round++) {
+        int i = 1 + rand() % 1999;
+        values[i] -= rand() % 100;
+        if (values[i] <= front)
+            values[i] = front + 1;
+        pairing_heap_decrease_key(&heap, nodes[i], &values[i]);
+        assert(pairing_heap_get(nodes[i]) == values[i]);
+    }
+
+    int min = values[1];
+    for (int i = 2; i < 2000; i++)
+        if (values[i] < min)
+            min = values[i];
+    assert(pairing_heap_peek(&heap) == min);
+
+    int prev = front;
+    size_t popped = 0;
+    while (!pairing_heap_empty(&heap)) {
+        int pop = pairing_heap_pop(&heap);
+        assert(prev <= pop);
+        prev = pop;
+        popped++;
+    }
+    assert(popped == 1999);
+
+    pairing_heap_free(&heap);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer decrease key pairing heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+int main(void)
+{
+    printf("Running dynamic pairing heap tests...\n");
+    test_int_push_pop_meld();
+    test_int_decrease_key();
+    printf("Completed dynamic pairing heap tests!\n");
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../include/hurust/dynamic/heap.h"
+#include "../../include/hurust/dynamic/radixheap.h"
+#include "../../include/hurust/functional/lambda.h"
+
+void test_int_push_pop(void)
+{
+    RADIX_HEAP(int, int);
+
+    struct int_radix_heap_t heap;
+    radix_heap_init(&heap, HR_GLOBAL_ALLOCATOR);
+
+    assert(radix_heap_empty(&heap));
+
+    uint64_t keys[] = { 5, 3, UINT64_MAX, 3, 0, 1ULL << 40, 17 };
+    for (int i = 0; i < 7; i++)
+        radix_heap_push(&heap, keys[i], &i);
+
+    assert(radix_heap_get_size(&heap) == 7);
+    assert(radix_heap_peek_key(&heap) == 0);
+
+    struct int_radix_heap_entry_t entry = radix_heap_pop(&heap);
+    assert(entry.key == 0 && entry.value == 4);
+
+    entry = radix_heap_pop(&heap);
+    assert(entry.key == 3);
+    entry = radix_heap_pop(&heap);
+    assert(entry.key == 3);
+
+    /* Keys equal to the last popped key can still be pushed. */
+    radix_heap_push(&heap, 3, &(int){ 42 });
+    entry = radix_heap_pop(&heap);
+    assert(entry.key == 3 && entry.value == 42);
+
+    entry = radix_heap_pop(&heap);
+    assert(entry.key == 5 && entry.value == 0);
+    entry = radix_heap_pop(&heap);
+    assert(entry.key == 17 && entry.value == 6);
+    entry = radix_heap_pop(&heap);
+    assert(entry.key == 1ULL << 40 && entry.value == 5);
+    assert(radix_heap_get_last(&heap) == 1ULL << 40);
+    entry = radix_heap_pop(&heap);
+    assert(entry.key == UINT64_MAX && entry.value == 2);
+
+    assert(radix_heap_empty(&heap));
+
+    radix_heap_free(&heap);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer push pop radix heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_event_simulation(void)
+{
+    RADIX_HEAP(size_t, event);
+    HEAP(uint64_t, u64);
+
+    struct event_radix_heap_t events;
+    struct u64_heap_t reference;
+    radix_heap_init(&events, HR_GLOBAL_ALLOCATOR);
+    heap_init(&reference, HR_GLOBAL_ALLOCATOR, 16,
+              lambda(int, (const uint64_t a, const uint64_t b), { return (a > b) - (a < b); }));
+
+    srand(9);
+    for (size_t i = 0; i < 1000; i++) {
+        uint64_t at = (uint64_t)(rand() % 100000);
+        radix_heap_push(&events, at, &i);
+        heap_push(&reference, &at);
+    }
+
+    /* Every event schedules a later one until the clock runs out. */
+    uint64_t clock = 0;
+    size_t popped = 0;
+    while (!radix_heap_empty(&events)) {
+        struct event_radix_heap_entry_t event = radix_heap_pop(&events);
+        assert(event.key >= clock);
+        assert(event.key == heap_pop(&reference));
+        clock = event.key;
+        popped++;
+        if (clock < 10000000) {
+            uint64_t at = clock + (uint64_t)(rand() % 100000);
+            radix_heap_push(&events, at, &event.value);
+            heap_push(&reference, &at);
+        }
+    }
+
+    assert(heap_empty(&reference));
+    assert(popped > 100000);
+
+    radix_heap_free(&events);
+    heap_free(&reference);
+
+    printf("------------------------------------------\n");
+    printf("Completed event simulation radix heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+int main(void)
+{
+    printf("Running dynamic radix heap tests...\n");
+    test_int_push_pop();
+    test_event_simulation();
+    printf("Completed dynamic radix heap tests!\n");
+    return 0;
+}
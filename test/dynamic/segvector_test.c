@@ -0,0 +1,155 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/hurust/dynamic/segvector.h"
+#include "../../include/hurust/functional/lambda.h"
+
+static size_t realloc_count = 0;
+
+void *counting_realloc(void *ptr, size_t size)
+{
+    realloc_count++;
+    return realloc(ptr, size);
+}
+
+HR_ALLOCATOR_NO_ARENA_INIT(counting_allocator, malloc, counting_realloc, free)
+
+void test_int_stable_pointers(void)
+{
+    SEG_VECTOR(int, int);
+
+    struct int_seg_vector_t vector;
+    seg_vector_init(&vector, &counting_allocator, 3,
+                    lambda(int, (const int a, const int b), { return a - b; }));
+
+    assert(seg_vector_empty(&vector));
+    assert(seg_vector_get_cap(&vector) == 0);
+
+    int item = 0;
+    seg_vector_push(&vector, &item);
+
+    /* The first chunk is rounded up to a power of two. */
+    assert(seg_vector_get_cap(&vector) == 4);
+
+    int *first = seg_vector_get_ptr(&vector, 0);
+
+    for (int i = 1; i < 100000; i++)
+        seg_vector_push(&vector, &i);
+
+    assert(realloc_count == 0);
+    assert(seg_vector_get_size(&vector) == 100000);
+    assert(first == seg_vector_get_ptr(&vector, 0));
+
+    int *ptrs[8];
+    for (int i = 0; i < 8; i++)
+        ptrs[i] = seg_vector_get_ptr(&vector, i * 12345);
+
+    for (int i = 100000; i < 300000; i++)
+        seg_vector_push(&vector, &i);
+
+    for (int i = 0; i < 8; i++) {
+        assert(ptrs[i] == seg_vector_get_ptr(&vector, i * 12345));
+        assert(*ptrs[i] == i * 12345);
+    }
+
+    for (int i = 0; i < 300000; i++)
+        assert(seg_vector_get(&vector, i) == i);
+
+    assert(realloc_count == 0);
+
+    seg_vector_free(&vector);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer stable pointer segmented vector tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_int_remove_shrink(void)
+{
+    SEG_VECTOR(int, int);
+
+    struct int_seg_vector_t vector;
+    seg_vector_init(&vector, HR_GLOBAL_ALLOCATOR, 1,
+                    lambda(int, (const int a, const int b), { return a - b; }));
+
+    seg_vector_reserve(&vector, 10);
+
+    assert(seg_vector_get_cap(&vector) >= 10);
+    assert(seg_vector_get_size(&vector) == 0);
+
+    for (int i = 0; i < 100; i++)
+        seg_vector_push(&vector, &i);
+
+    assert(seg_vector_max(&vector) == 99);
+    assert(seg_vector_min(&vector) == 0);
+
+    assert(seg_vector_pop_back(&vector) == 99);
+    assert(seg_vector_swap_remove(&vector, 5) == 5);
+    assert(seg_vector_get(&vector, 5) == 98);
+    assert(seg_vector_get_size(&vector) == 98);
+
+    seg_vector_set(&vector, &(int){ -1 }, 0);
+    assert(seg_vector_min(&vector) == -1);
+
+    long sum = 0;
+    seg_vector_foreach(&vector, lambda(void, (int *x), { sum += *x; }));
+    assert(sum == 99 * 100 / 2 - 99 - 5 - 1);
+
+    while (seg_vector_get_size(&vector) > 10)
+        seg_vector_pop_back(&vector);
+
+    int *kept = seg_vector_get_ptr(&vector, 9);
+    size_t cap = seg_vector_get_cap(&vector);
+
+    seg_vector_shrink_to_fit(&vector);
+
+    assert(seg_vector_get_cap(&vector) < cap);
+    assert(seg_vector_get_cap(&vector) >= seg_vector_get_size(&vector));
+    assert(kept == seg_vector_get_ptr(&vector, 9));
+    assert(*kept == 9);
+
+    for (int i = 10; i < 1000; i++)
+        seg_vector_push(&vector, &i);
+
+    for (int i = 1; i < 1000; i++)
+        assert(seg_vector_get(&vector, i) == (i == 5 ? 98 : i));
+
+    *seg_vector_emplace(&vector) = 1000;
+    assert(seg_vector_get(&vector, 1000) == 1000);
+    assert(seg_vector_get_size(&vector) == 1001);
+
+    seg_vector_free(&vector);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer remove shrink segmented vector tests\n");
+    printf("------------------------------------------\n");
+}
+
+int main(void)
+{
+    printf("Running dynamic segmented vector tests...\n");
+    test_int_stable_pointers();
+    test_int_remove_shrink();
+    printf("Completed dynamic segmented vector tests!\n");
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/hurust/dynamic/smallvector.h"
+#include "../../include/hurust/functional/lambda.h"
+
+static size_t alloc_count = 0;
+
+void *counting_malloc(size_t size)
+{
+    alloc_count++;
+    return malloc(size);
+}
+
+void *counting_realloc(void *ptr, size_t size)
+{
+    alloc_count++;
+    return realloc(ptr, size);
+}
+
+HR_ALLOCATOR_NO_ARENA_INIT(counting_allocator, counting_malloc, counting_realloc, free)
+
+void test_int_inline(void)
+{
+    SMALL_VECTOR(int, int, 8);
+
+    struct int_small_vector_t vector;
+    small_vector_init(&vector, &counting_allocator,
+                      lambda(int, (const int a, const int b), { return a - b; }));
+
+    alloc_count = 0;
+
+    assert(small_vector_empty(&vector));
+    assert(small_vector_get_cap(&vector) == 8);
+
+    for (int i = 8; i > 0; i--)
+        small_vector_push(&vector, &i);
+
+    assert(alloc_count == 0);
+    assert(small_vector_is_inline(&vector));
+    assert(small_vector_get_size(&vector) == 8);
+    assert(small_vector_max(&vector) == 8);
+    assert(small_vector_min(&vector) == 1);
+
+    small_vector_sort(&vector);
+
+    for (int i = 0; i < 8; i++)
+        assert(small_vector_get(&vector, i) == i + 1);
+
+    assert(small_vector_pop(&vector, 0) == 1);
+    assert(small_vector_get(&vector, 0) == 2);
+    assert(small_vector_swap_remove(&vector, 0) == 2);
+    assert(small_vector_get(&vector, 0) == 8);
+    assert(small_vector_get_size(&vector) == 6);
+
+    small_vector_set(&vector, &(int){ 42 }, 0);
+    assert(small_vector_get(&vector, 0) == 42);
+
+    small_vector_free(&vector);
+
+    assert(alloc_count == 0);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer inline small vector tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_int_spill(void)
+{
+    SMALL_VECTOR(int, int, 4);
+
+    struct int_small_vector_t vector;
+    small_vector_init(&vector, &counting_allocator,
+                      lambda(int, (const int a, const int b), { return a - b; }));
+
+    alloc_count = 0;
+
+    for (int i = 0; i < 4; i++)
+        small_vector_push(&vector, &i);
+
+    assert(small_vector_is_inline(&vector));
+
+    for (int i = 4; i < 1000; i++)
+        small_vector_push(&vector, &i);
+
+    assert(!small_vector_is_inline(&vector));
+    assert(small_vector_get_size(&vector) == 1000);
+    assert(small_vector_get_cap(&vector) >= 1000);
+
+    for (int i = 0; i < 1000; i++)
+        assert(small_vector_get(&vector, i) == i);
+
+    size_t spilled_allocs = alloc_count;
+
+    while (!small_vector_empty(&vector))
+        small_vector_pop(&vector, small_vector_get_size(&vector) - 1);
+
+    assert(alloc_count == spilled_allocs);
+
+    *small_vector_emplace(&vector) = 7;
+    assert(small_vector_get(&vector, 0) == 7);
+    assert(small_vector_get_size(&vector) == 1);
+
+    small_vector_free(&vector);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer spill small vector tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_str_reserve(void)
+{
+    SMALL_VECTOR(char *, str, 2);
+
+    struct str_small_vector_t vector;
+    small_vector_init(&vector, &counting_allocator,
+                      lambda(int, (const char *a, const char *b), { return strcmp(a, b); }));
+
+    alloc_count = 0;
+
+    small_vector_push(&vector, &(char *){ "c" });
+    small_vector_push(&vector, &(char *){ "a" });
+
+    small_vector_reserve(&vector, 14);
+
+    assert(alloc_count == 1);
+    assert(small_vector_get_cap(&vector) >= 16);
+    assert(!small_vector_is_inline(&vector));
+
+    small_vector_push(&vector, &(char *){ "b" });
+
+    assert(alloc_count == 1);
+
+    small_vector_sort(&vector);
+
+    assert(strcmp(small_vector_get(&vector, 0), "a") == 0);
+    assert(strcmp(small_vector_get(&vector, 1), "b") == 0);
+    assert(strcmp(small_vector_get(&vector, 2), "c") == 0);
+
+    small_vector_free(&vector);
+
+    printf("------------------------------------------\n");
+    printf("Completed string reserve small vector tests\n");
+    printf("------------------------------------------\n");
+}
+
+int main(void)
+{
+    printf("Running dynamic small vector tests...\n");
+    test_int_inline();
+    test_int_spill();
+    test_str_reserve();
+    printf("Completed dynamic small vector tests!\n");
+    return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/hurust/dynamic/soavector.h"
+#include "../../include/hurust/functional/lambda.h"
+
+static size_t alloc_count = 0;
+
+void *counting_malloc(size_t size)
+{
+    alloc_count++;
+    return malloc(size);
+}
+
+HR_ALLOCATOR_NO_ARENA_INIT(counting_allocator, counting_malloc, realloc, free)
+
+#define PARTICLE_FIELDS(X) \
+    X(double, x)           \
+    X(float, mass)         \
+    X(char, tag)           \
+    X(int64_t, id)         \
+    X(char *, name)
+
+void test_push_get(void)
+{
+    SOA_VECTOR(PARTICLE_FIELDS, particle);
+
+    struct particle_soa_vector_t soa;
+    soa_vector_init(&soa, PARTICLE_FIELDS, &counting_allocator, 2);
+
+    assert(soa_vector_empty(&soa));
+    assert(soa_vector_get_cap(&soa) >= 2);
+
+    alloc_count = 0;
+
+    for (int i = 0; i < 1000; i++) {
+        struct particle_soa_row_t row = {
+            .x = i * 0.5, .mass = (float)i, .tag = 'a' + i % 26, .id = -i, .name = "p"
+        };
+        soa_vector_push(&soa, PARTICLE_FIELDS, &row);
+    }
+
+    size_t growths = alloc_count;
+    size_t cap = 2;
+    size_t expected_growths = 0;
+    while (cap < 1000) {
+        cap *= 2;
+        expected_growths++;
+    }
+    assert(growths == expected_growths);
+
+    assert(soa_vector_get_size(&soa) == 1000);
+
+    for (int i = 0; i < 1000; i++) {
+        struct particle_soa_row_t row = soa_vector_get(&soa, PARTICLE_FIELDS, i);
+        assert(row.x == i * 0.5);
+        assert(row.mass == (float)i);
+        assert(row.tag == 'a' + i % 26);
+        assert(row.id == -i);
+        assert(strcmp(row.name, "p") == 0);
+        assert(soa_vector_get_field(&soa, id, i) == -i);
+    }
+
+    const double *xs = soa_vector_get_column(&soa, x);
+    double sum = 0;
+    for (size_t i = 0; i < soa_vector_get_size(&soa); i++)
+        sum += xs[i];
+    assert(sum == 0.5 * 999 * 1000 / 2);
+
+    for (size_t c = 0; c < sizeof(soa._cols) / sizeof(*soa._cols); c++)
+        assert(((uintptr_t)soa._cols[c] & (HR_SOA_COLUMN_ALIGN - 1)) == 0);
+
+    soa_vector_set_field(&soa, mass, &(float){ 42.0f }, 10);
+    assert(soa_vector_get(&soa, PARTICLE_FIELDS, 10).mass == 42.0f);
+    assert(soa_vector_get(&soa, PARTICLE_FIELDS, 10).id == -10);
+
+    struct particle_soa_row_t row = { .x = 1, .mass = 2, .tag = 'z', .id = 3, .name = "q" };
+    soa_vector_set(&soa, PARTICLE_FIELDS, &row, 0);
+    assert(soa_vector_get_field(&soa, tag, 0) == 'z');
+    assert(soa_vector_get_field(&soa, x, 0) == 1);
+
+    soa_vector_free(&soa);
+
+    printf("------------------------------------------\n");
+    printf("Completed push get soa vector tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_swap_remove_sort(void)
+{
+    SOA_VECTOR(PARTICLE_FIELDS, particle);
+
+    struct particle_soa_vector_t soa;
+    soa_vector_init(&soa, PARTICLE_FIELDS, HR_GLOBAL_ALLOCATOR, 4);
+
+    for (int i = 0; i < 10; i++) {
+        struct particle_soa_row_t row = {
+            .x = i, .mass = (float)(i % 3), .tag = 'a' + i, .id = i, .name = NULL
+        };
+        soa_vector_push(&soa, PARTICLE_FIELDS, &row);
+    }
+
+    struct particle_soa_row_t removed = soa_vector_swap_remove(&soa, PARTICLE_FIELDS, 2);
+
+    assert(removed.id == 2);
+    assert(soa_vector_get_size(&soa) == 9);
+    assert(soa_vector_get_field(&soa, id, 2) == 9);
+    assert(soa_vector_get_field(&soa, tag, 2) == 'a' + 9);
+    assert(soa_vector_get_field(&soa, x, 2) == 9);
+
+    soa_vector_sort_by(&soa, mass,
+                       lambda(int, (const float a, const float b), { return (a > b) - (a < b); }));
+
+    /* Stable by mass, so ids within a mass keep the order they had. */
+    int64_t expected[] = { 0, 9, 3, 6, 1, 4, 7, 5, 8 };
+    for (size_t i = 0; i < soa_vector_get_size(&soa); i++) {
+        struct particle_soa_row_t row = soa_vector_get(&soa, PARTICLE_FIELDS, i);
+        assert(row.id == expected[i]);
+        assert(row.x == expected[i]);
+        assert(row.tag == 'a' + expected[i]);
+        assert(row.mass == (float)(expected[i] % 3));
+    }
+
+    double total = 0;
+    soa_vector_foreach_field(&soa, x, lambda(void, (const double *x), { total += *x; }));
+    assert(total == 45 - 2);
+
+    soa_vector_free(&soa);
+
+    printf("------------------------------------------\n");
+    printf("Completed swap remove sort soa vector tests\n");
+    printf("------------------------------------------\n");
+}
+
+int main(void)
+{
+    printf("Running dynamic soa vector tests...\n");
+    test_push_get();
+    test_swap_remove_sort();
+    printf("Completed dynamic soa vector tests!\n");
+    return 0;
+}
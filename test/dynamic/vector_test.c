@@ -24,6 +24,16 @@
 #include "../../include/hurust/dynamic/vector.h"
 #include "../../include/hurust/functional/lambda.h"
 
+static size_t realloc_count = 0;
+
+void *counting_realloc(void *ptr, size_t size)
+{
+    realloc_count++;
+    return realloc(ptr, size);
+}
+
+HR_ALLOCATOR_NO_ARENA_INIT(counting_allocator, malloc, counting_realloc, free)
+
 void test_int_push_pop_get(void)
 {
     VECTOR(int, int);
@@ -232,6 +242,304 @@ void test_str_push_many_sort(void)
     printf("------------------------------------------\n");
 }
 
+void test_int_pop_swap_remove(void)
+{
+    VECTOR(int, int);
+
+    struct int_vector_t vector;
+    vector_init(&vector, HR_GLOBAL_ALLOCATOR, 16,
+                lambda(int, (const int a, const int b), { return a - b; }));
+
+    for (int i = 0; i < 8; i++)
+        vector_push(&vector, &i);
+
+    int pop = vector_pop(&vector, 2);
+
+    assert(pop == 2);
+    assert(vector_get_size(&vector) == 7);
+    assert(vector_get(&vector, 1) == 1);
+    assert(vector_get(&vector, 2) == 3);
+    assert(vector_get(&vector, 6) == 7);
+
+    int removed = vector_swap_remove(&vector, 1);
+
+    assert(removed == 1);
+    assert(vector_get_size(&vector) == 6);
+    assert(vector_get(&vector, 1) == 7);
+    assert(vector_get(&vector, 5) == 6);
+
+    removed = vector_swap_remove(&vector, 5);
+
+    assert(removed == 6);
+    assert(vector_get_size(&vector) == 5);
+
+    vector_free(&vector);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer pop swap remove vector tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_int_bulk_operations(void)
+{
+    VECTOR(int, int);
+
+    struct int_vector_t vector;
+    vector_init(&vector, HR_GLOBAL_ALLOCATOR, 2,
+                lambda(int, (const int a, const int b), { return a - b; }));
+
+    vector_reserve(&vector, 100);
+
+    assert(vector_get_cap(&vector) > 100);
+    assert(vector_empty(&vector));
+
+    int items[1000];
+    for (int i = 0; i < 1000; i++)
+        items[i] = i;
+
+    vector_append_array(&vector, items, 1000);
+
+    assert(vector_get_size(&vector) == 1000);
+    for (int i = 0; i < 1000; i++)
+        assert(vector_get(&vector, i) == i);
+
+    struct int_vector_t other;
+    vector_init(&other, HR_GLOBAL_ALLOCATOR, 2,
+                lambda(int, (const int a, const int b), { return a - b; }));
+
+    vector_resize(&other, 10, &(int){ 7 });
+
+    assert(vector_get_size(&other) == 10);
+    for (int i = 0; i < 10; i++)
+        assert(vector_get(&other, i) == 7);
+
+    vector_extend(&vector, &other);
+
+    assert(vector_get_size(&vector) == 1010);
+    assert(vector_get(&vector, 999) == 999);
+    assert(vector_get(&vector, 1009) == 7);
+
+    vector_extend(&vector, &vector);
+
+    assert(vector_get_size(&vector) == 2020);
+    assert(vector_get(&vector, 1010) == 0);
+    assert(vector_get(&vector, 2019) == 7);
+
+    vector_resize(&vector, 5, &(int){ 0 });
+
+    assert(vector_get_size(&vector) == 5);
+    assert(vector_get(&vector, 4) == 4);
+
+    vector_push(&vector, &(int){ 5 });
+
+    assert(vector_get(&vector, 5) == 5);
+
+    vector_free(&other);
+    vector_free(&vector);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer bulk operation vector tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_int_growth_policy(void)
+{
+    VECTOR(int, int);
+
+    struct int_vector_t vector;
+    vector_init(&vector, &counting_allocator, 1,
+                lambda(int, (const int a, const int b), { return a - b; }));
+
+    for (int i = 0; i < 4; i++)
+        vector_push(&vector, &i);
+
+    assert(vector_get_size(&vector) == 4);
+    assert(vector_get_cap(&vector) == 4);
+
+    const HRGrowthPolicy policy = {
+        .growth_factor = 1.5f, .shrink_threshold = 4, .min_cap = 16, .never_shrink = true
+    };
+    vector_set_policy(&vector, &policy);
+
+    for (int i = 4; i < 1000; i++)
+        vector_push(&vector, &i);
+
+    realloc_count = 0;
+
+    for (int round = 0; round < 100; round++) {
+        while (!vector_empty(&vector))
+            vector_pop(&vector, vector_get_size(&vector) - 1);
+        for (int i = 0; i < 1000; i++)
+            vector_push(&vector, &i);
+    }
+
+    assert(realloc_count == 0);
+
+    vector_set_policy(&vector, HR_DEFAULT_GROWTH_POLICY);
+
+    while (!vector_empty(&vector))
+        vector_pop(&vector, vector_get_size(&vector) - 1);
+
+    assert(vector_get_cap(&vector) <= 4);
+
+    realloc_count = 0;
+
+    for (int round = 0; round < 100; round++) {
+        vector_push(&vector, &round);
+        vector_pop(&vector, 0);
+    }
+
+    assert(realloc_count <= 1);
+
+    vector_free(&vector);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer growth policy vector tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_int_sorted_operations(void)
+{
+    VECTOR(int, int);
+
+    struct int_vector_t vector;
+    vector_init(&vector, HR_GLOBAL_ALLOCATOR, 2,
+                lambda(int, (const int a, const int b), { return a - b; }));
+
+    assert(vector_bsearch(&vector, 1) == -1);
+    assert(vector_lower_bound(&vector, 1) == 0);
+
+    int items[] = { 5, 1, 9, 3, 7, 3, 5, 0, 9 };
+
+    for (size_t i = 0; i < sizeof(items) / sizeof(*items); i++)
+        vector_insert_sorted(&vector, &items[i]);
+
+    assert(vector_get_size(&vector) == 9);
+
+    for (size_t i = 1; i < vector_get_size(&vector); i++)
+        assert(vector_get(&vector, i - 1) <= vector_get(&vector, i));
+
+    // 0 1 3 3 5 5 7 9 9
+    assert(vector_lower_bound(&vector, 3) == 2);
+    assert(vector_upper_bound(&vector, 3) == 4);
+    assert(vector_lower_bound(&vector, 4) == 4);
+    assert(vector_upper_bound(&vector, 9) == 9);
+    assert(vector_lower_bound(&vector, -1) == 0);
+    assert(vector_bsearch(&vector, 5) == 4);
+    assert(vector_bsearch(&vector, 0) == 0);
+    assert(vector_bsearch(&vector, 9) == 7);
+    assert(vector_bsearch(&vector, 4) == -1);
+    assert(vector_bsearch(&vector, 10) == -1);
+
+    assert(vector_remove_sorted(&vector, 3));
+    assert(vector_remove_sorted(&vector, 3));
+    assert(!vector_remove_sorted(&vector, 3));
+    assert(vector_get_size(&vector) == 7);
+
+    vector_insert(&vector, &(int){ 42 }, 0);
+    vector_insert(&vector, &(int){ 43 }, vector_get_size(&vector));
+    vector_insert(&vector, &(int){ 44 }, 4);
+
+    int expected[] = { 42, 0, 1, 5, 44, 5, 7, 9, 9, 43 };
+
+    assert(vector_get_size(&vector) == sizeof(expected) / sizeof(*expected));
+    for (size_t i = 0; i < vector_get_size(&vector); i++)
+        assert(vector_get(&vector, i) == expected[i]);
+
+    vector_free(&vector);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer sorted vector tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_record_emplace(void)
+{
+    struct record {
+        int key;
+        char payload[252];
+    };
+
+    VECTOR(struct record, record);
+
+    struct record_vector_t vector;
+    vector_init(&vector, HR_GLOBAL_ALLOCATOR, 1,
+                lambda(int, (const struct record a, const struct record b),
+                       { return a.key - b.key; }));
+
+    for (int i = 0; i < 100; i++) {
+        struct record *slot = vector_emplace(&vector);
+        slot->key = i;
+        memset(slot->payload, i, sizeof(slot->payload));
+    }
+
+    assert(vector_get_size(&vector) == 100);
+
+    for (int i = 0; i < 100; i++) {
+        assert(vector_get(&vector, i).key == i);
+        assert(vector_get(&vector, i).payload[251] == (char)i);
+    }
+
+    vector_free(&vector);
+
+    printf("------------------------------------------\n");
+    printf("Completed record emplace vector tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_int_retain_dedup(void)
+{
+    VECTOR(int, int);
+
+    struct int_vector_t vector;
+    vector_init(&vector, HR_GLOBAL_ALLOCATOR, 2,
+                lambda(int, (const int a, const int b), { return a - b; }));
+
+    assert(vector_retain(&vector, lambda(bool, (const int *x), { return *x > 0; })) == 0);
+    assert(vector_dedup(&vector) == 0);
+
+    for (int i = 0; i < 1000; i++)
+        vector_push(&vector, &i);
+
+    size_t calls = 0;
+    size_t removed = vector_retain(&vector, lambda(bool, (const int *x), {
+                                       calls++;
+                                       return *x % 3 == 0;
+                                   }));
+
+    assert(calls == 1000);
+    assert(removed == 666);
+    assert(vector_get_size(&vector) == 334);
+    for (size_t i = 0; i < vector_get_size(&vector); i++)
+        assert(vector_get(&vector, i) == (int)i * 3);
+
+    assert(vector_get_cap(&vector) == 1024);
+
+    /* Removing everything at once shrinks all the way down, not one halving. */
+    assert(vector_retain(&vector, lambda(bool, (const int *x), { return *x < 0; })) == 334);
+    assert(vector_empty(&vector));
+    assert(vector_get_cap(&vector) < HR_DEFAULT_GROWTH_POLICY->shrink_threshold);
+
+    int items[] = { 5, 1, 3, 3, 1, 5, 5, 2, 9, 1 };
+    vector_append_array(&vector, items, sizeof(items) / sizeof(*items));
+    vector_sort(&vector);
+
+    assert(vector_dedup(&vector) == 5);
+
+    int expected[] = { 1, 2, 3, 5, 9 };
+    assert(vector_get_size(&vector) == 5);
+    for (size_t i = 0; i < 5; i++)
+        assert(vector_get(&vector, i) == expected[i]);
+
+    assert(vector_dedup(&vector) == 0);
+
+    vector_free(&vector);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer retain dedup vector tests\n");
+    printf("------------------------------------------\n");
+}
+
 int main(void)
 {
     printf("Running dynamic vector tests...\n");
@@ -239,6 +547,12 @@ int main(void)
     test_str_push_pop_get();
     test_int_push_many_sort();
     test_str_push_many_sort();
+    test_int_pop_swap_remove();
+    test_int_bulk_operations();
+    test_int_growth_policy();
+    test_int_sorted_operations();
+    test_record_emplace();
+    test_int_retain_dedup();
     printf("Completed dynamic vector tests!\n");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../include/hurust/extsort.h"
+#include "../include/hurust/functional/lambda.h"
+
+void run_int_external_sort(size_t size, size_t run_len)
+{
+    FILE *in = tmpfile();
+    FILE *out = tmpfile();
+    int *items = malloc(sizeof(int) * (size + 1));
+    long long sum = 0;
+
+    srand(42);
+    for (size_t i = 0; i < size; i++) {
+        items[i] = rand() % 100000 - 50000;
+        sum += items[i];
+    }
+    assert(write(fileno(in), items, sizeof(int) * size) == (ssize_t)(sizeof(int) * size));
+    lseek(fileno(in), 0, SEEK_SET);
+
+    int ret = external_sort(int, fileno(in), fileno(out), HR_GLOBAL_ALLOCATOR, run_len,
+                            lambda(int, (const int a, const int b), { return a - b; }));
+
+    assert(ret == 0);
+
+    lseek(fileno(out), 0, SEEK_SET);
+    memset(items, 0, sizeof(int) * (size + 1));
+    assert(read(fileno(out), items, sizeof(int) * (size + 1)) == (ssize_t)(sizeof(int) * size));
+
+    for (size_t i = 0; i < size; i++) {
+        if (i > 0)
+            assert(items[i - 1] <= items[i]);
+        sum -= items[i];
+    }
+    assert(sum == 0);
+
+    free(items);
+    fclose(in);
+    fclose(out);
+}
+
+void test_int_external_sort(void)
+{
+    run_int_external_sort(100000, 1000);
+    run_int_external_sort(100000, 100000);
+    run_int_external_sort(1000, 1001);
+    run_int_external_sort(1, 1);
+    run_int_external_sort(0, 16);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer external sort tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_partial_record_external_sort(void)
+{
+    FILE *in = tmpfile();
+    FILE *out = tmpfile();
+    char bytes[] = { 1, 2, 3, 4, 5, 6 };
+
+    assert(write(fileno(in), bytes, sizeof(bytes)) == sizeof(bytes));
+    lseek(fileno(in), 0, SEEK_SET);
+
+    int ret = external_sort(int, fileno(in), fileno(out), HR_GLOBAL_ALLOCATOR, 4,
+                            lambda(int, (const int a, const int b), { return a - b; }));
+
+    assert(ret == -1);
+
+    fclose(in);
+    fclose(out);
+
+    printf("------------------------------------------\n");
+    printf("Completed partial record external sort tests\n");
+    printf("------------------------------------------\n");
+}
+
+int main(void)
+{
+    printf("Running external sort tests...\n");
+    test_int_external_sort();
+    test_partial_record_external_sort();
+    printf("Completed external sort tests!\n");
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../include/hurust/dynamic/vector.h"
+#include "../include/hurust/functional/lambda.h"
+#include "../include/hurust/simd.h"
+#include "../include/hurust/static/array.h"
+
+#define MAX_SIZE 1000
+
+/*
+ * Checks every kernel for the given type against a plain loop for all sizes
+ * up to MAX_SIZE, so every split between vector blocks and the scalar tail
+ * is covered.
+ */
+#define CHECK_KERNELS(type, sum_type, gen)                              \
+    ({                                                                  \
+        type *arr = malloc(sizeof(type) * MAX_SIZE);                    \
+        for (size_t i = 0; i < MAX_SIZE; i++)                           \
+            arr[i] = (type)(gen);                                       \
+        for (size_t n = 0; n <= MAX_SIZE; n++) {                        \
+            sum_type sum = 0;                                           \
+            for (size_t i = 0; i < n; i++)                              \
+                sum += arr[i];                                          \
+            assert(simd_sum(arr, n) == sum);                            \
+            if (n == 0) {                                               \
+                assert(simd_find(arr, n, arr[0]) == -1);                \
+                assert(simd_count(arr, n, arr[0]) == 0);                \
+                continue;                                               \
+            }                                                           \
+            type min = arr[0], max = arr[0];                            \
+            for (size_t i = 1; i < n; i++) {                            \
+                min = arr[i] < min ? arr[i] : min;                      \
+                max = arr[i] > max ? arr[i] : max;                      \
+            }                                                           \
+            assert(simd_min(arr, n) == min);                            \
+            assert(simd_max(arr, n) == max);                            \
+            const type needle = arr[n / 2];                             \
+            size_t count = 0;                                           \
+            ssize_t first = -1;                                         \
+            for (size_t i = 0; i < n; i++) {                            \
+                if (arr[i] == needle) {                                 \
+                    count++;                                            \
+                    if (first == -1)                                    \
+                        first = i;                                      \
+                }                                                       \
+            }                                                           \
+            assert(simd_count(arr, n, needle) == count);                \
+            assert(simd_find(arr, n, needle) == first);                 \
+            assert(simd_find((const type *)arr, n, max) <= (ssize_t)n); \
+        }                                                               \
+        free(arr);                                                      \
+    })
+
+void test_integer_kernels(void)
+{
+    srand(42);
+
+    CHECK_KERNELS(int8_t, int64_t, rand() % 256 - 128);
+    CHECK_KERNELS(uint8_t, uint64_t, rand() % 256);
+    CHECK_KERNELS(int16_t, int64_t, rand() % 65536 - 32768);
+    CHECK_KERNELS(uint16_t, uint64_t, rand() % 65536);
+    CHECK_KERNELS(int32_t, int64_t, rand() - RAND_MAX / 2);
+    CHECK_KERNELS(uint32_t, uint64_t, (uint32_t)rand() * 2);
+    CHECK_KERNELS(int64_t, int64_t, ((int64_t)rand() << 20) - ((int64_t)RAND_MAX << 19));
+    CHECK_KERNELS(uint64_t, uint64_t, (uint64_t)rand() << 20);
+    CHECK_KERNELS(char, int64_t, rand() % 128);
+    CHECK_KERNELS(long long, long long, ((long long)rand() << 20) - ((long long)RAND_MAX << 19));
+    CHECK_KERNELS(unsigned long long, unsigned long long, (unsigned long long)rand() << 20);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer simd tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_float_kernels(void)
+{
+    srand(42);
+
+    /* Small integers are summed exactly in any order. */
+    CHECK_KERNELS(float, double, rand() % 2001 - 1000);
+    CHECK_KERNELS(double, double, rand() % 2001 - 1000);
+
+    float arr[] = { 0.5f, -0.0f, 3.25f, -7.5f, 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+    size_t n = sizeof(arr) / sizeof(*arr);
+
+    assert(simd_min(arr, n) == -7.5f);
+    assert(simd_max(arr, n) == 5.0f);
+    assert(simd_count(arr, n, 0.0f) == 2);
+    assert(simd_find(arr, n, 0.0f) == 1);
+
+    printf("------------------------------------------\n");
+    printf("Completed float simd tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_collection_wrappers(void)
+{
+    VECTOR(int32_t, i32);
+
+    struct i32_vector_t vector;
+    vector_init(&vector, HR_GLOBAL_ALLOCATOR, 2,
+                lambda(int, (const int32_t a, const int32_t b), { return a - b; }));
+
+    for (int32_t i = 0; i < 100; i++)
+        vector_push(&vector, &(int32_t){ (i * 37) % 100 - 50 });
+
+    assert(vector_simd_min(&vector) == vector_min(&vector));
+    assert(vector_simd_max(&vector) == vector_max(&vector));
+    assert(vector_simd_sum(&vector) == -50);
+    assert(vector_simd_count(&vector, 49) == 1);
+    assert(vector_simd_find(&vector, -50) == 0);
+    assert(vector_simd_find(&vector, 50) == -1);
+
+    vector_free(&vector);
+
+    ARRAY(double, f64);
+
+    struct f64_array_t array;
+    array_init(&array, HR_GLOBAL_ALLOCATOR, 64,
+               lambda(int, (const double a, const double b), { return (a > b) - (a < b); }));
+
+    for (int i = 0; i < 64; i++)
+        array_push(&array, &(double){ i % 8 });
+
+    assert(array_simd_min(&array) == 0.0);
+    assert(array_simd_max(&array) == 7.0);
+    assert(array_simd_sum(&array) == 8 * 28.0);
+    assert(array_simd_count(&array, 3.0) == 8);
+    assert(array_simd_find(&array, 7.0) == 7);
+
+    array_free(&array);
+
+    printf("------------------------------------------\n");
+    printf("Completed collection simd tests\n");
+    printf("------------------------------------------\n");
+}
+
+int main(void)
+{
+    printf("Running simd tests...\n");
+    test_integer_kernels();
+    test_float_kernels();
+    test_collection_wrappers();
+    printf("Completed simd tests!\n");
+    return 0;
+}
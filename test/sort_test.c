@@ -0,0 +1,289 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/hurust/common.h"
+#include "../include/hurust/functional/lambda.h"
+#include "../include/hurust/sort.h"
+
+void test_int_sort_natural(void)
+{
+    const size_t size = 10000;
+    int *arr = malloc(sizeof(int) * size);
+    int *expected = malloc(sizeof(int) * size);
+
+    srand(42);
+    for (size_t i = 0; i < size; i++) {
+        arr[i] = rand() - RAND_MAX / 2;
+        expected[i] = arr[i];
+    }
+
+    sort(expected, size, lambda(int, (const int a, const int b), { return (a > b) - (a < b); }));
+    sort_natural(arr, size);
+
+    assert(memcmp(arr, expected, sizeof(int) * size) == 0);
+
+    free(arr);
+    free(expected);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer natural sort tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_double_sort_natural(void)
+{
+    const size_t size = 10000;
+    double *arr = malloc(sizeof(double) * size);
+
+    srand(42);
+    for (size_t i = 0; i < size; i++)
+        arr[i] = (double)rand() / RAND_MAX - 0.5;
+
+    sort_natural(arr, size);
+
+    for (size_t i = 1; i < size; i++)
+        assert(arr[i - 1] <= arr[i]);
+
+    free(arr);
+
+    printf("------------------------------------------\n");
+    printf("Completed double natural sort tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_sort_natural_small(void)
+{
+    long long one[] = { 5 };
+    sort_natural(one, 1);
+    assert(one[0] == 5);
+
+    long long few[] = { 3, -1, 2, 2, -7 };
+    sort_natural(few, 5);
+    assert(few[0] == -7 && few[1] == -1 && few[2] == 2 && few[3] == 2 && few[4] == 3);
+
+    printf("------------------------------------------\n");
+    printf("Completed small natural sort tests\n");
+    printf("------------------------------------------\n");
+}
+
+/*
+ * Sorts arrays of every size up to 2000 in a few distributions with
+ * sort_natural and checks them against sort, so both the partition and the
+ * small range sort of the SIMD kernels are covered.
+ */
+#define CHECK_SORT_NATURAL(type, gen)                                 \
+    ({                                                                \
+        type *arr = malloc(sizeof(type) * 2000);                      \
+        type *expected = malloc(sizeof(type) * 2000);                 \
+        for (size_t n = 0; n <= 2000; n += 1 + n / 8) {               \
+            for (int dist = 0; dist < 4; dist++) {                    \
+                for (size_t i = 0; i < n; i++) {                      \
+                    arr[i] = dist == 0 ? (type)(gen)                  \
+                             : dist == 1 ? (type)(rand() % 4)         \
+                             : dist == 2 ? (type)i                    \
+                                         : (type)(n - i);             \
+                    expected[i] = arr[i];                             \
+                }                                                     \
+                sort(expected, n, _sort_natural_cmp);                 \
+                sort_natural(arr, n);                                 \
+                assert(memcmp(arr, expected, sizeof(type) * n) == 0); \
+            }                                                         \
+        }                                                             \
+        free(arr);                                                    \
+        free(expected);                                               \
+    })
+
+void test_sort_natural_kernels(void)
+{
+    srand(42);
+
+    CHECK_SORT_NATURAL(int32_t, rand() - RAND_MAX / 2);
+    CHECK_SORT_NATURAL(uint32_t, (uint32_t)rand() * 2);
+    CHECK_SORT_NATURAL(int64_t, ((int64_t)rand() << 32) - rand());
+    CHECK_SORT_NATURAL(uint64_t, (uint64_t)rand() << 33);
+    CHECK_SORT_NATURAL(float, rand() % 100000 - 50000.5f);
+    CHECK_SORT_NATURAL(double, (double)rand() / 7 - 1e8);
+    CHECK_SORT_NATURAL(long long, rand() - RAND_MAX / 2);
+    /* No kernel, sorted by the quicksort. */
+    CHECK_SORT_NATURAL(int16_t, rand() % 65536 - 32768);
+
+    printf("------------------------------------------\n");
+    printf("Completed natural sort kernel tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_sort_dispatch(void)
+{
+    const size_t size = 5000;
+    int *arr = malloc(sizeof(int) * size);
+
+    srand(42);
+    for (size_t i = 0; i < size; i++)
+        arr[i] = rand() % 2001 - 1000;
+
+    int (*asc)(const int, const int) =
+        lambda(int, (const int a, const int b), { return (a > b) - (a < b); });
+    int (*desc)(const int, const int) =
+        lambda(int, (const int a, const int b), { return (a < b) - (a > b); });
+
+    sort_dispatch(arr, size, asc);
+    for (size_t i = 1; i < size; i++)
+        assert(arr[i - 1] <= arr[i]);
+
+    /* Comparison functions that are not the natural order fall back to sort. */
+    sort_dispatch(arr, size, desc);
+    for (size_t i = 1; i < size; i++)
+        assert(arr[i - 1] >= arr[i]);
+
+    sort_dispatch(arr, size, lambda(int, (const int a, const int b), { return abs(a) - abs(b); }));
+    for (size_t i = 1; i < size; i++)
+        assert(abs(arr[i - 1]) <= abs(arr[i]));
+
+    free(arr);
+
+    printf("------------------------------------------\n");
+    printf("Completed dispatched sort tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_sort_by_key(void)
+{
+    struct record {
+        int id;
+        double weight;
+    };
+
+    const size_t size = 5000;
+    struct record *arr = malloc(sizeof(struct record) * size);
+
+    srand(42);
+    for (size_t i = 0; i < size; i++)
+        arr[i] = (struct record){ .id = (int)i, .weight = (double)(rand() % 100) };
+
+    static size_t key_calls = 0;
+    sort_by_key(arr, size, lambda(double, (const struct record r), {
+                    key_calls++;
+                    return r.weight;
+                }));
+
+    assert(key_calls == size);
+
+    for (size_t i = 1; i < size; i++) {
+        assert(arr[i - 1].weight <= arr[i].weight);
+        if (arr[i - 1].weight == arr[i].weight)
+            assert(arr[i - 1].id < arr[i].id);
+    }
+
+    free(arr);
+
+    printf("------------------------------------------\n");
+    printf("Completed sort by key tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_sort_by_key_cmp(void)
+{
+    char *arr[] = { "delta", "Alpha", "charlie", "Bravo", "alpha" };
+    const size_t size = sizeof(arr) / sizeof(*arr);
+
+    sort_by_key_cmp(arr, size, lambda(char *, (char *const str), {
+                        static char keys[8][16];
+                        static size_t next = 0;
+                        char *key = keys[next++ % 8];
+                        size_t i = 0;
+                        for (; str[i] != '\0' && i < 15; i++)
+                            key[i] = (str[i] >= 'A' && str[i] <= 'Z') ? str[i] + 32 : str[i];
+                        key[i] = '\0';
+                        return key;
+                    }),
+                    strcmp);
+
+    assert(strcmp(arr[0], "Alpha") == 0);
+    assert(strcmp(arr[1], "alpha") == 0);
+    assert(strcmp(arr[2], "Bravo") == 0);
+    assert(strcmp(arr[3], "charlie") == 0);
+    assert(strcmp(arr[4], "delta") == 0);
+
+    printf("------------------------------------------\n");
+    printf("Completed sort by key with comparison tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_argsort_apply_permutation(void)
+{
+    const size_t size = 5000;
+    int *keys = malloc(sizeof(int) * size);
+    double *values = malloc(sizeof(double) * size);
+    char *tags = malloc(sizeof(char) * size);
+    size_t *idx = malloc(sizeof(size_t) * size);
+
+    srand(42);
+    for (size_t i = 0; i < size; i++) {
+        keys[i] = rand() % 1000;
+        values[i] = keys[i] * 0.5;
+        tags[i] = (char)('a' + keys[i] % 26);
+    }
+
+    argsort(keys, size, lambda(int, (const int a, const int b), { return a - b; }), idx);
+
+    for (size_t i = 1; i < size; i++) {
+        assert(keys[idx[i - 1]] <= keys[idx[i]]);
+        if (keys[idx[i - 1]] == keys[idx[i]])
+            assert(idx[i - 1] < idx[i]);
+    }
+
+    apply_permutation(keys, size, idx);
+    apply_permutation(values, size, idx);
+    apply_permutation(tags, size, idx);
+
+    for (size_t i = 0; i < size; i++) {
+        if (i > 0)
+            assert(keys[i - 1] <= keys[i]);
+        assert(values[i] == keys[i] * 0.5);
+        assert(tags[i] == (char)('a' + keys[i] % 26));
+    }
+
+    free(keys);
+    free(values);
+    free(tags);
+    free(idx);
+
+    printf("------------------------------------------\n");
+    printf("Completed argsort and permutation tests\n");
+    printf("------------------------------------------\n");
+}
+
+int main(void)
+{
+    printf("Running sort tests...\n");
+    test_int_sort_natural();
+    test_double_sort_natural();
+    test_sort_natural_small();
+    test_sort_natural_kernels();
+    test_sort_dispatch();
+    test_sort_by_key();
+    test_sort_by_key_cmp();
+    test_argsort_apply_permutation();
+    printf("Completed sort tests!\n");
+    return 0;
+}
@@ -250,6 +250,75 @@ void test_str_push_many_sort(void)
     printf("------------------------------------------\n");
 }
 
+void test_int_pop_swap_remove(void)
+{
+    ARRAY(int, int);
+
+    struct int_array_t array;
+    array_init(&array, HR_GLOBAL_ALLOCATOR, 16,
+               lambda(int, (const int a, const int b), { return a - b; }));
+
+    for (int i = 0; i < 8; i++)
+        array_push(&array, &i);
+
+    int pop = array_pop(&array, 2);
+
+    assert(pop == 2);
+    assert(array_get_size(&array) == 7);
+    assert(array_get(&array, 1) == 1);
+    assert(array_get(&array, 2) == 3);
+    assert(array_get(&array, 6) == 7);
+
+    int removed = array_swap_remove(&array, 1);
+
+    assert(removed == 1);
+    assert(array_get_size(&array) == 6);
+    assert(array_get(&array, 1) == 7);
+    assert(array_get(&array, 5) == 6);
+
+    removed = array_swap_remove(&array, 5);
+
+    assert(removed == 6);
+    assert(array_get_size(&array) == 5);
+
+    array_free(&array);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer pop swap remove array tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_str_retain_dedup(void)
+{
+    ARRAY(char *, str);
+
+    struct str_array_t array;
+    array_init(&array, HR_GLOBAL_ALLOCATOR, 8, strcmp);
+
+    char *items[] = { "b", "a", "bb", "a", "ccc", "b", "a", "dd" };
+    for (size_t i = 0; i < 8; i++)
+        array_push(&array, &items[i]);
+
+    assert(array_retain(&array, lambda(bool, (char *const *s), { return strlen(*s) == 1; })) == 3);
+    assert(array_get_size(&array) == 5);
+    assert(strcmp(array_get(&array, 0), "b") == 0);
+    assert(strcmp(array_get(&array, 1), "a") == 0);
+    assert(strcmp(array_get(&array, 4), "a") == 0);
+
+    array_sort(&array);
+
+    assert(array_dedup(&array) == 3);
+    assert(array_get_size(&array) == 2);
+    assert(strcmp(array_get(&array, 0), "a") == 0);
+    assert(strcmp(array_get(&array, 1), "b") == 0);
+
+    array_free(&array);
+
+    printf("------------------------------------------\n");
+    printf("Completed string retain dedup array tests\n");
+    printf("------------------------------------------\n");
+}
+
 int main(void)
 {
     printf("Running static array tests...\n");
@@ -257,6 +326,8 @@ int main(void)
     test_str_push_pop_get();
     test_int_push_many_sort();
     test_str_push_many_sort();
+    test_int_pop_swap_remove();
+    test_str_retain_dedup();
     printf("Completed static array tests!\n");
     return 0;
 }
\ No newline at end of file
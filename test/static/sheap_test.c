@@ -0,0 +1,120 @@
+/*
+ *  Copyright (C) 2023 Callum Gran
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/hurust/functional/lambda.h"
+#include "../../include/hurust/static/sheap.h"
+
+static int int_desc(const void *a, const void *b)
+{
+    return (*(const int *)b > *(const int *)a) - (*(const int *)b < *(const int *)a);
+}
+
+void test_int_top_k(void)
+{
+    SHEAP(int, int);
+
+    struct int_sheap_t heap;
+    /* Larger items are better, so the heap keeps the largest ones. */
+    sheap_init(&heap, HR_GLOBAL_ALLOCATOR, 100,
+               lambda(int, (const int a, const int b), { return (b > a) - (b < a); }));
+
+    const size_t n = 1000000;
+    int *items = malloc(sizeof(int) * n);
+    srand(5);
+    for (size_t i = 0; i < n; i++)
+        items[i] = rand();
+
+    size_t kept = 0;
+    for (size_t i = 0; i < n; i++)
+        kept += sheap_push(&heap, &items[i]);
+
+    assert(sheap_full(&heap));
+    assert(sheap_get_size(&heap) == 100);
+    assert(kept < n / 100);
+
+    qsort(items, n, sizeof(int), int_desc);
+
+    assert(sheap_peek(&heap) == items[99]);
+
+    int top[100];
+    assert(sheap_drain(&heap, top) == 100);
+    assert(sheap_empty(&heap));
+
+    for (size_t i = 0; i < 100; i++)
+        assert(top[i] == items[i]);
+
+    free(items);
+    sheap_free(&heap);
+
+    printf("------------------------------------------\n");
+    printf("Completed integer top k static heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+void test_str_push_pop(void)
+{
+    SHEAP(char *, str);
+
+    struct str_sheap_t heap;
+    sheap_init(&heap, HR_GLOBAL_ALLOCATOR, 3,
+               lambda(int, (const char *a, const char *b), { return strcmp(a, b); }));
+
+    assert(sheap_empty(&heap));
+
+    assert(sheap_push(&heap, &(char *){ "d" }));
+    assert(sheap_push(&heap, &(char *){ "b" }));
+    assert(sheap_push(&heap, &(char *){ "e" }));
+    assert(sheap_full(&heap));
+
+    assert(strcmp(sheap_peek(&heap), "e") == 0);
+    assert(!sheap_push(&heap, &(char *){ "f" }));
+    assert(!sheap_push(&heap, &(char *){ "e" }));
+    assert(sheap_push(&heap, &(char *){ "a" }));
+    assert(strcmp(sheap_peek(&heap), "d") == 0);
+
+    assert(strcmp(sheap_pop(&heap), "d") == 0);
+    assert(sheap_get_size(&heap) == 2);
+
+    char *out[3];
+    assert(sheap_drain(&heap, out) == 2);
+    assert(strcmp(out[0], "a") == 0);
+    assert(strcmp(out[1], "b") == 0);
+
+    sheap_push(&heap, &(char *){ "c" });
+    sheap_clear(&heap);
+    assert(sheap_empty(&heap));
+
+    sheap_free(&heap);
+
+    printf("------------------------------------------\n");
+    printf("Completed string push pop static heap tests\n");
+    printf("------------------------------------------\n");
+}
+
+int main(void)
+{
+    printf("Running static heap tests...\n");
+    test_int_top_k();
+    test_str_push_pop();
+    printf("Completed static heap tests!\n");
+    return 0;
+}